@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ContractionHierarchy.h"
+#include "Generators.h"
+#include "Graph.h"
+
+using namespace std;
+
+/*   Graph      10^2  10^7 .
+    :  ,  ,  
+   .  - JSON  stdout    --out */
+
+struct Options {
+    long long minEdges = 100;
+    long long maxEdges = 10000000;
+    int degree = 8; //     
+    string shape = "er"; //  : er, rmat, ba, grid
+    string order = "none"; //    : none, rcm, degree, bfs
+    int reps = 30; //     
+    double budget = 2.0; //     
+    bool limits = true; //      
+    bool stats = false; //     (  GRAPH_STATS)
+    Exec policy = Exec::sequential;
+    int threads = 0;
+    unsigned seed = 1;
+    string dir = ".";
+    string out;
+    vector<string> ops;
+};
+
+struct Result {
+    string op, graph;
+    long long edges;
+    int vertexs;
+    vector<double> ms; //  
+    long long peakKb;
+};
+
+const char* allOps[] = { "load", "printToFile", "addEdge", "deleteVertex", "getEdgeList", "findPath",
+    "amountOfConnectedParts", "carcass", "shortestWays", "getRadius", "kShortestWays", "maxFlow", "reorder", "snapshot",
+    "loadCompressed", "compressedConnectedParts", "compressedShortestWays", "chBuild", "chDistance" };
+
+//      : getRadius, carcass   -
+//  kShortestWays   V*E,  maxFlow       .
+//     ,       
+long long edgeLimit(const string& op) {
+    if (op == "getRadius" || op == "carcass" || op == "kShortestWays" || op == "chBuild" || op == "chDistance") return 100000;
+    if (op == "maxFlow") return 1000000;
+    return -1;
+}
+
+void usage() {
+    cerr << "usage: graph_bench [--min-edges N] [--max-edges N] [--degree D] [--shape er|rmat|ba|grid] [--order none|rcm|degree|bfs] [--reps N] [--budget SEC]\n"
+        << "    [--ops op1,op2,...] [--parallel] [--threads N] [--seed S] [--dir DIR] [--out FILE] [--no-limits] [--stats]\n"
+        << "ops:";
+    for (auto op : allOps) cerr << " " << op;
+    cerr << "\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        auto value = [&]() -> string {
+            if (i + 1 >= argc) throw invalid_argument(a);
+            return argv[++i];
+        };
+        if (a == "--min-edges") o.minEdges = stoll(value());
+        else if (a == "--max-edges") o.maxEdges = stoll(value());
+        else if (a == "--degree") o.degree = stoi(value());
+        else if (a == "--shape") {
+            o.shape = value();
+            if (o.shape != "er" && o.shape != "rmat" && o.shape != "ba" && o.shape != "grid") throw invalid_argument(o.shape);
+        }
+        else if (a == "--order") {
+            o.order = value();
+            if (o.order != "none" && o.order != "rcm" && o.order != "degree" && o.order != "bfs") throw invalid_argument(o.order);
+        }
+        else if (a == "--reps") o.reps = stoi(value());
+        else if (a == "--budget") o.budget = stod(value());
+        else if (a == "--parallel") o.policy = Exec::parallel;
+        else if (a == "--threads") o.threads = stoi(value());
+        else if (a == "--seed") o.seed = stoul(value());
+        else if (a == "--dir") o.dir = value();
+        else if (a == "--out") o.out = value();
+        else if (a == "--no-limits") o.limits = false;
+        else if (a == "--stats") o.stats = true;
+        else if (a == "--ops") {
+            stringstream ss(value());
+            string op;
+            while (getline(ss, op, ',')) {
+                if (find(begin(allOps), end(allOps), op) == end(allOps)) throw invalid_argument(op);
+                o.ops.push_back(op);
+            }
+        }
+        else return false;
+    }
+    if (o.ops.empty()) o.ops.assign(begin(allOps), end(allOps));
+    return o.minEdges > 0 && o.maxEdges >= o.minEdges && o.degree > 0 && o.reps > 0;
+}
+
+//      (VmHWM); resetPeak  ,    
+long long peakRss() {
+    ifstream in("/proc/self/status");
+    string line;
+    while (getline(in, line))
+        if (line.compare(0, 6, "VmHWM:") == 0) return stoll(line.substr(6));
+    return 0;
+}
+
+void resetPeak() {
+    ofstream out("/proc/self/clear_refs");
+    if (out.is_open()) out << "5";
+}
+
+VertexOrder vertexOrder(const Options& o) {
+    if (o.order == "degree") return VertexOrder::degree;
+    if (o.order == "bfs") return VertexOrder::bfs;
+    return VertexOrder::rcm;
+}
+
+//       edges 
+GraphGenerator makeGenerator(const Options& o, long long edges, unsigned long long seed) {
+    int n = (int)max(2LL, edges / o.degree);
+    if (o.shape == "rmat") {
+        int scale = 1;
+        while ((1LL << scale) < n) scale++;
+        return GraphGenerator::rmat(scale, (int)max(1LL, edges >> scale), seed);
+    }
+    if (o.shape == "ba") return GraphGenerator::barabasiAlbert(n, o.degree, seed);
+    if (o.shape == "grid") {
+        int side = (int)max(2.0, sqrt(edges / 2.0));
+        return GraphGenerator::grid(side, side, seed);
+    }
+    return GraphGenerator::erdosRenyi(n, edges, seed);
+}
+
+/*  op,    reps       (   ).
+ Err   : ,      */
+vector<double> measure(const Options& o, const function<void()>& op) {
+    vector<double> ms;
+    auto total = chrono::steady_clock::now();
+    while ((int)ms.size() < o.reps) {
+        auto start = chrono::steady_clock::now();
+        try { op(); }
+        catch (Err&) {}
+        auto stop = chrono::steady_clock::now();
+        ms.push_back(chrono::duration<double, milli>(stop - start).count());
+        if (chrono::duration<double>(stop - total).count() > o.budget) break;
+    }
+    return ms;
+}
+
+double percentile(const vector<double>& sorted, double p) {
+    size_t i = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[min(i, sorted.size() - 1)];
+}
+
+void writeJson(ostream& out, const Options& o, const vector<Result>& results) {
+    out << "{\n  \"benchmark\": \"graph\",\n  \"shape\": \"" << o.shape << "\",\n  \"order\": \"" << o.order << "\",\n  \"policy\": \"" << (o.policy == Exec::parallel ? "parallel" : "sequential")
+        << "\",\n  \"threads\": " << (o.policy == Exec::parallel ? ThreadPool::instance().size() : 1)
+        << ",\n  \"seed\": " << o.seed << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        vector<double> s = r.ms;
+        sort(s.begin(), s.end());
+        double sum = 0;
+        for (double x : s) sum += x;
+        double mean = sum / s.size();
+        char buf[512];
+        snprintf(buf, sizeof(buf),
+            "\"op\": \"%s\", \"graph\": \"%s\", \"edges\": %lld, \"vertices\": %d, \"samples\": %d, "
+            "\"ops_per_sec\": %.3f, \"edges_per_sec\": %.1f, \"mean_ms\": %.4f, \"min_ms\": %.4f, "
+            "\"p50_ms\": %.4f, \"p90_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f, \"peak_rss_kb\": %lld",
+            r.op.c_str(), r.graph.c_str(), r.edges, r.vertexs, (int)s.size(),
+            mean > 0 ? 1000.0 / mean : 0.0, mean > 0 ? r.edges * 1000.0 / mean : 0.0, mean, s.front(),
+            percentile(s, 0.5), percentile(s, 0.9), percentile(s, 0.99), s.back(), r.peakKb);
+        out << (i ? ",\n" : "\n") << "    {" << buf << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int main(int argc, char** argv) {
+    Options o;
+    try {
+        if (!parseArgs(argc, argv, o)) {
+            usage();
+            return 1;
+        }
+    }
+    catch (exception& e) {
+        cerr << "bad argument: " << e.what() << "\n";
+        usage();
+        return 1;
+    }
+    if (o.threads > 0) ThreadPool::setDefaultThreads(o.threads);
+    auto wanted = [&](const string& op) { return find(o.ops.begin(), o.ops.end(), op) != o.ops.end(); };
+
+    vector<Result> results;
+    for (long long edges = o.minEdges; edges <= o.maxEdges; edges *= 10) {
+        GraphGenerator gen = makeGenerator(o, edges, o.seed + edges);
+        int n = gen.vertexCount();
+        mt19937 rng(o.seed ^ (unsigned)edges);
+        //        ,    
+        vector<int> renamed(n + 1);
+        for (int v = 0; v <= n; ++v) renamed[v] = v;
+        auto anyVertex = [&]() { return renamed[(int)(rng() % n) + 1]; };
+        string dFile = o.dir + "/bench_" + to_string(edges) + "_d.txt";
+        string uFile = o.dir + "/bench_" + to_string(edges) + "_u.txt";
+        string outFile = o.dir + "/bench_" + to_string(edges) + "_out.txt";
+        gen.directed(true).write(dFile, Exec::parallel);
+
+        auto run = [&](const string& op, const string& graph, const function<void()>& body) {
+            if (!wanted(op)) return;
+            if (o.limits && edgeLimit(op) >= 0 && edges > edgeLimit(op)) return;
+            cerr << op << " " << graph << " " << edges << " edges..." << flush;
+            resetPeak();
+            Result r = { op, graph, gen.edgeCount(), n, measure(o, body), 0 };
+            r.peakKb = peakRss();
+            cerr << " " << r.ms.size() << " samples\n";
+            results.push_back(r);
+        };
+
+        //   ;       
+        Graph d(true, true);
+        run("load", "directed", [&]() { d = Graph(dFile, o.policy); });
+        if (!wanted("load")) d = Graph(dFile, o.policy);
+        //     ;     1..n
+        run("reorder", "directed", [&]() { d.reorder(vertexOrder(o), o.policy); });
+        if (o.order != "none") {
+            pair<Graph, vector<int>> r = d.reorder(vertexOrder(o), o.policy);
+            d = r.first;
+            for (int i = 0; i < (int)r.second.size(); ++i) renamed[r.second[i]] = i + 1;
+        }
+        run("printToFile", "directed", [&]() { d.printToFile(outFile, o.policy); });
+        remove(outFile.c_str());
+        {
+            Graph copy(d);
+            run("addEdge", "directed", [&]() { copy.addEdge(anyVertex(), anyVertex(), 1); });
+        }
+        {
+            Graph copy(d);
+            vector<int> order(n);
+            for (int i = 0; i < n; ++i) order[i] = i + 1;
+            shuffle(order.begin(), order.end(), rng);
+            int next = 0;
+            run("deleteVertex", "directed", [&]() { copy.deleteVertex(order[next++ % n]); });
+        }
+        {
+            //      :        
+            Graph copy(d);
+            int next = n;
+            run("snapshot", "directed", [&]() {
+                Graph s = copy.snapshot();
+                copy.addVertex(++next);
+            });
+        }
+        run("getEdgeList", "directed", [&]() { d.getEdgeList(o.policy); });
+        run("findPath", "directed", [&]() { d.findPath(anyVertex(), anyVertex(), anyVertex()); });
+        run("amountOfConnectedParts", "directed", [&]() { d.amountOfConnectedParts(o.policy); });
+        run("shortestWays", "directed", [&]() { d.shortestWays(anyVertex(), anyVertex(), anyVertex()); });
+        run("kShortestWays", "directed", [&]() { d.kShortestWays(anyVertex(), anyVertex(), 1, o.policy); });
+        run("maxFlow", "directed", [&]() { d.maxFlow(anyVertex(), anyVertex(), o.policy); });
+        if ((wanted("chBuild") || wanted("chDistance")) && !(o.limits && edges > edgeLimit("chBuild"))) {
+            //      
+            unique_ptr<ContractionHierarchy> ch;
+            run("chBuild", "directed", [&]() { ch = make_unique<ContractionHierarchy>(d, o.policy); });
+            if (!ch) ch = make_unique<ContractionHierarchy>(d, o.policy);
+            run("chDistance", "directed", [&]() { ch->distance(anyVertex(), anyVertex()); });
+        }
+        d = Graph(true, true);
+
+        //       ,      
+        if (wanted("loadCompressed") || wanted("compressedConnectedParts") || wanted("compressedShortestWays")) {
+            run("loadCompressed", "compressed", [&]() { CompressedGraph(dFile).size(); });
+            CompressedGraph c(dFile);
+            auto original = [&]() { return (int)(rng() % n) + 1; };
+            run("compressedConnectedParts", "compressed", [&]() { c.amountOfConnectedParts(); });
+            run("compressedShortestWays", "compressed", [&]() { c.shortestWays(original(), original(), original()); });
+        }
+        remove(dFile.c_str());
+
+        if (wanted("carcass") || wanted("getRadius")) {
+            gen.directed(false).write(uFile, Exec::parallel);
+            Graph u(uFile, o.policy);
+            remove(uFile.c_str());
+            if (o.order != "none") u = u.reorder(vertexOrder(o), o.policy).first;
+            run("carcass", "undirected", [&]() { u.carcass(o.policy); });
+            run("getRadius", "undirected", [&]() { u.getRadius(o.policy); });
+        }
+    }
+
+    if (o.stats) GraphStats::print(cerr);
+    if (o.out.empty()) writeJson(cout, o, results);
+    else {
+        ofstream out(o.out);
+        if (!out.is_open()) {
+            cerr << "cannot open " << o.out << "\n";
+            return 1;
+        }
+        writeJson(out, o, results);
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <algorithm>
+#include <cstdint>
+#include "Arena.h"
+
+namespace {
+	//   ,    
+	const size_t maxBlock = 1 << 24;
+
+	vector<void (*)()>& scratchPools() {
+		thread_local vector<void (*)()> pools;
+		return pools;
+	}
+}
+
+Arena::Arena(size_t blockSize) : current(nullptr), left(0), blockSize(max<size_t>(blockSize, 64)), total(0) {}
+
+void* Arena::allocate(size_t bytes, size_t align) {
+	size_t pad = (align - reinterpret_cast<uintptr_t>(this->current) % align) % align;
+	if (pad + bytes > this->left) {
+		size_t size = max(this->blockSize, bytes + align);
+		this->blocks.push_back(unique_ptr<char[]>(new char[size]));
+		GRAPH_STATS_ADD(bytes, size);
+		this->current = this->blocks.back().get();
+		this->left = size;
+		this->blockSize = min(this->blockSize * 2, maxBlock);
+		pad = (align - reinterpret_cast<uintptr_t>(this->current) % align) % align;
+	}
+	char* p = this->current + pad;
+	this->current += pad + bytes;
+	this->left -= pad + bytes;
+	this->total += bytes;
+	return p;
+}
+
+void Arena::release() {
+	this->blocks.clear();
+	this->current = nullptr;
+	this->left = 0;
+	this->total = 0;
+}
+
+void registerScratchPool(void (*clear)()) {
+	scratchPools().push_back(clear);
+}
+
+void releaseScratch() {
+	for (auto clear : scratchPools()) clear();
+}
@@ -0,0 +1,99 @@
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Stats.h"
+
+using namespace std;
+
+#pragma once
+/*  :           ,
+    release  .     
+(  ),      .   */
+class Arena
+{
+public:
+	explicit Arena(size_t blockSize = 1 << 16);
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	void* allocate(size_t bytes, size_t align);
+	void release(); //    
+	size_t allocated() const { return this->total; } //      release
+
+private:
+	vector<unique_ptr<char[]>> blocks;
+	char* current;
+	size_t left; //    
+	size_t blockSize; //   ,  
+	size_t total;
+};
+
+//       Arena; deallocate   
+template<class T>
+class ArenaAllocator
+{
+public:
+	typedef T value_type;
+
+	ArenaAllocator(Arena& arena) : arena(&arena) {}
+	template<class U> ArenaAllocator(const ArenaAllocator<U>& a) : arena(a.arena) {}
+
+	T* allocate(size_t n) { return static_cast<T*>(this->arena->allocate(n * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) {}
+
+	template<class U> bool operator==(const ArenaAllocator<U>& a) const { return this->arena == a.arena; }
+	template<class U> bool operator!=(const ArenaAllocator<U>& a) const { return this->arena != a.arena; }
+
+	Arena* arena;
+};
+
+template<class T> using ArenaVector = vector<T, ArenaAllocator<T>>;
+
+void registerScratchPool(void (*clear)()); //  ScratchVector:  ,  releaseScratch   
+void releaseScratch(); //      
+
+/*   ,     .      
+   ,           */
+template<class T>
+class ScratchVector
+{
+public:
+	explicit ScratchVector(size_t n = 0, const T& value = T()) {
+		vector<vector<T>>& free = pool();
+		if (!free.empty()) {
+			this->v.swap(free.back());
+			free.pop_back();
+		}
+#ifdef GRAPH_STATS
+		this->reused = this->v.capacity();
+#endif
+		this->v.assign(n, value);
+	}
+	~ScratchVector() {
+		//           
+		GRAPH_STATS_ADD(bytes, (this->v.capacity() - this->reused) * sizeof(T));
+		this->v.clear();
+		pool().push_back(move(this->v));
+	}
+	ScratchVector(const ScratchVector&) = delete;
+	ScratchVector& operator=(const ScratchVector&) = delete;
+
+	vector<T>& operator*() { return this->v; }
+	vector<T>* operator->() { return &this->v; }
+	T& operator[](size_t i) { return this->v[i]; }
+	const T& operator[](size_t i) const { return this->v[i]; }
+
+private:
+	static vector<vector<T>>& pool() {
+		thread_local vector<vector<T>> free;
+		thread_local bool known = (registerScratchPool(&ScratchVector::clear), true);
+		(void)known;
+		return free;
+	}
+	static void clear() { vector<vector<T>>().swap(pool()); }
+
+	vector<T> v;
+#ifdef GRAPH_STATS
+	size_t reused;
+#endif
+};
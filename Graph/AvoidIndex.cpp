@@ -0,0 +1,226 @@
+#include <algorithm>
+#include "AvoidIndex.h"
+#include "Arena.h"
+
+namespace {
+	//      
+	const int cacheLimit = 64;
+
+	//         ; degree(v) -   v, child(v, i) - i- 
+	template<class Degree, class Child>
+	void number(Degree degree, Child child, int root, vector<int>& tin, vector<int>& tout, int& timer) {
+		ScratchVector<pair<int, int>> st(1, make_pair(root, 0));
+		tin[root] = timer++;
+		while (!st->empty()) {
+			int v = st->back().first;
+			if (st->back().second < degree(v)) {
+				int u = child(v, st->back().second++);
+				tin[u] = timer++;
+				st->push_back(make_pair(u, 0));
+			}
+			else {
+				tout[v] = timer++;
+				st->pop_back();
+			}
+		}
+	}
+}
+
+AvoidIndex::AvoidIndex(shared_ptr<const Csr> g, shared_ptr<const Csr> inv, bool directed) : g(g), inv(inv), directed(directed) {
+	if (!directed) this->buildBlockCut();
+}
+
+void AvoidIndex::buildBlockCut() {
+	GRAPH_STATS_SCOPE("AvoidIndex::blockCut");
+	const Csr& g = *this->g;
+	int n = g.size();
+	vector<int> disc(n, -1), low(n, 0), st;
+	//       ,    
+	Arena arena;
+	ArenaAllocator<int> alloc(arena);
+	vector<ArenaVector<int>> tree(n, ArenaVector<int>(alloc)); //    
+	int timer = 0;
+
+	//    :  ,  low[u] >= disc[v]   u
+	for (int r = 0; r < n; ++r) {
+		if (disc[r] >= 0) continue;
+		disc[r] = low[r] = timer++;
+		GRAPH_STATS_ADD(visited, 1);
+		st.assign(1, r);
+		vector<pair<int, int>> dfs(1, make_pair(r, g.offset[r]));
+		vector<int> parent(1, -1);
+		while (!dfs.empty()) {
+			int v = dfs.back().first;
+			if (dfs.back().second < g.offset[v + 1]) {
+				int u = g.target[dfs.back().second++];
+				GRAPH_STATS_ADD(relaxed, 1);
+				if (u == v || u == parent.back()) continue;
+				if (disc[u] < 0) {
+					disc[u] = low[u] = timer++;
+					GRAPH_STATS_ADD(visited, 1);
+					st.push_back(u);
+					dfs.push_back(make_pair(u, g.offset[u]));
+					parent.push_back(v);
+				}
+				else low[v] = min(low[v], disc[u]);
+				continue;
+			}
+			dfs.pop_back();
+			int p = parent.back();
+			parent.pop_back();
+			if (p < 0) break;
+			low[p] = min(low[p], low[v]);
+			if (low[v] >= disc[p]) {
+				int block = tree.size();
+				tree.push_back(ArenaVector<int>(1, p, alloc));
+				tree[p].push_back(block);
+				int x;
+				do {
+					x = st.back(); st.pop_back();
+					tree[block].push_back(x);
+					tree[x].push_back(block);
+				} while (x != v);
+			}
+		}
+	}
+
+	//  :  ,      LCA
+	int m = tree.size();
+	this->blockCut.tin.assign(m, -1);
+	this->blockCut.tout.assign(m, -1);
+	this->component.assign(m, -1);
+	int levels = 1;
+	while ((1 << levels) < m) levels++;
+	this->jump.assign(levels, vector<int>(m, 0));
+	vector<ArenaVector<int>> children(m, ArenaVector<int>(alloc));
+	for (int r = 0; r < m; ++r) {
+		if (this->component[r] >= 0) continue;
+		this->component[r] = r;
+		this->jump[0][r] = r;
+		vector<int> q(1, r);
+		for (size_t i = 0; i < q.size(); ++i)
+			for (int u : tree[q[i]])
+				if (this->component[u] < 0) {
+					this->component[u] = r;
+					this->jump[0][u] = q[i];
+					children[q[i]].push_back(u);
+					q.push_back(u);
+				}
+	}
+	for (int k = 1; k < levels; ++k)
+		for (int x = 0; x < m; ++x)
+			this->jump[k][x] = this->jump[k - 1][this->jump[k - 1][x]];
+	timer = 0;
+	for (int r = 0; r < m; ++r)
+		if (this->component[r] == r)
+			number([&](int v) { return (int)children[v].size(); }, [&](int v, int i) { return children[v][i]; },
+				r, this->blockCut.tin, this->blockCut.tout, timer);
+}
+
+int AvoidIndex::lca(int a, int b) {
+	if (this->blockCut.ancestor(a, b)) return a;
+	if (this->blockCut.ancestor(b, a)) return b;
+	for (int k = this->jump.size() - 1; k >= 0; --k)
+		if (!this->blockCut.ancestor(this->jump[k][a], b)) a = this->jump[k][a];
+	return this->jump[0][a];
+}
+
+shared_ptr<const AvoidIndex::Tree> AvoidIndex::dominators(int s) {
+	{
+		lock_guard<mutex> lk(this->cacheM);
+		auto it = this->cache.find(s);
+		if (it != this->cache.end()) return it->second;
+	}
+	GRAPH_STATS_SCOPE("AvoidIndex::dominators");
+	const Csr& g = *this->g, &inv = *this->inv;
+	int n = g.size();
+
+	//     s
+	ScratchVector<int> order, rpo(n, -1);
+	ScratchVector<pair<int, int>> st(1, make_pair(s, g.offset[s]));
+	rpo[s] = 0;
+	while (!st->empty()) {
+		int v = st->back().first;
+		if (st->back().second < g.offset[v + 1]) {
+			int u = g.target[st->back().second++];
+			GRAPH_STATS_ADD(relaxed, 1);
+			if (rpo[u] < 0) {
+				rpo[u] = 0;
+				st->push_back(make_pair(u, g.offset[u]));
+			}
+		}
+		else {
+			order->push_back(v);
+			st->pop_back();
+		}
+	}
+	GRAPH_STATS_ADD(visited, order->size());
+	reverse(order->begin(), order->end());
+	for (int i = 0; i < (int)order->size(); ++i) rpo[order[i]] = i;
+
+	//   --
+	ScratchVector<int> idom(n, -1);
+	idom[s] = s;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (int i = 1; i < (int)order->size(); ++i) {
+			int v = order[i], best = -1;
+			GRAPH_STATS_ADD(relaxed, inv.degree(v));
+			for (int a = inv.offset[v]; a < inv.offset[v + 1]; ++a) {
+				int p = inv.target[a];
+				if (idom[p] < 0) continue;
+				if (best < 0) {
+					best = p;
+					continue;
+				}
+				int x = p, y = best;
+				while (x != y) {
+					while (rpo[x] > rpo[y]) x = idom[x];
+					while (rpo[y] > rpo[x]) y = idom[y];
+				}
+				best = x;
+			}
+			if (idom[v] != best) {
+				idom[v] = best;
+				changed = true;
+			}
+		}
+	}
+
+	//    :    idom
+	ScratchVector<int> first(n + 1, 0), children(order->size());
+	for (int v : *order)
+		if (v != s) first[idom[v] + 1]++;
+	for (int v = 0; v < n; ++v) first[v + 1] += first[v];
+	for (int v : *order)
+		if (v != s) (*children)[first[idom[v]]++] = v;
+	for (int v = n; v > 0; --v) first[v] = first[v - 1];
+	first[0] = 0;
+	shared_ptr<Tree> t = make_shared<Tree>();
+	t->tin.assign(n, -1);
+	t->tout.assign(n, -1);
+	int timer = 0;
+	number([&](int v) { return first[v + 1] - first[v]; }, [&](int v, int i) { return children[first[v] + i]; },
+		s, t->tin, t->tout, timer);
+
+	lock_guard<mutex> lk(this->cacheM);
+	if (this->cache.size() >= cacheLimit) this->cache.clear();
+	this->cache[s] = t;
+	return t;
+}
+
+bool AvoidIndex::separates(int u1, int u2, int v) {
+	if (u1 == u2) return false;
+	if (u2 == v) return true;
+	if (this->directed) {
+		shared_ptr<const Tree> dom = this->dominators(u1);
+		if (dom->tin[u2] < 0) return true;
+		return v != u1 && dom->ancestor(v, u2);
+	}
+	if (this->component[u1] != this->component[u2]) return true;
+	if (v == u1) return false;
+	// v      u1  u2,          LCA
+	int l = this->lca(u1, u2);
+	return this->blockCut.ancestor(l, v) && (this->blockCut.ancestor(v, u1) || this->blockCut.ancestor(v, u2));
+}
@@ -0,0 +1,43 @@
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Csr.h"
+
+using namespace std;
+
+#pragma once
+/*        u1  u2   v.
+   -     : v  u1  u2,
+          (  O(log n)).
+  -     u1: v ,   u2 (  O(1)).
+         */
+class AvoidIndex
+{
+public:
+	AvoidIndex(shared_ptr<const Csr> g, shared_ptr<const Csr> inv, bool directed);
+	bool separates(int u1, int u2, int v); //  Csr; true,     v 
+
+private:
+	//        
+	struct Tree
+	{
+		vector<int> tin, tout; // tin = -1    
+		bool ancestor(int a, int b) const { return tin[a] <= tin[b] && tout[b] <= tout[a]; }
+	};
+
+	void buildBlockCut(); //     
+	shared_ptr<const Tree> dominators(int s); //     s
+	int lca(int a, int b);
+
+	shared_ptr<const Csr> g, inv;
+	bool directed;
+
+	//  :   0..n-1 -  ,  - 
+	Tree blockCut;
+	vector<int> component; //    
+	vector<vector<int>> jump; // jump[k][x] -  x  2^k  
+
+	mutex cacheM;
+	map<int, shared_ptr<const Tree>> cache; //    
+};
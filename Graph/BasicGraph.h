@@ -0,0 +1,372 @@
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <type_traits>
+#include <vector>
+#include "Graph.h"
+
+using namespace std;
+
+#pragma once
+/* ,     :    (int, long long),   (int, long long, double,
+void - )  .     ,    
+   ,     .  Graph      */
+
+// :   ;     
+template<class VertexId, class Weight>
+struct BasicArc
+{
+	VertexId to;
+	Weight weight;
+};
+
+template<class VertexId>
+struct BasicArc<VertexId, void>
+{
+	VertexId to;
+};
+
+//    ,   
+template<class VertexId, class Weight>
+struct BasicEdge
+{
+	VertexId from, to;
+	Weight weight;
+};
+
+template<class VertexId>
+struct BasicEdge<VertexId, void>
+{
+	VertexId from, to;
+};
+
+template<class VertexId, class Weight = void, bool Directed = true>
+class BasicGraph
+{
+public:
+	static constexpr bool directed = Directed;
+	static constexpr bool weighted = !is_void<Weight>::value;
+	typedef BasicArc<VertexId, Weight> Arc;
+	typedef BasicEdge<VertexId, Weight> Edge;
+	typedef conditional_t<weighted, Weight, int> WeightArg; //    ,    
+	//  :     ,    
+	typedef conditional_t<is_floating_point<WeightArg>::value, double, long long> Distance;
+
+	BasicGraph() {}
+
+	//  Graph   ,  
+	explicit BasicGraph(Graph& g) {
+		if (g.isDirected() != Directed || g.isWeighted() != weighted)
+			throw OperationErr("graph kind does not match");
+		map<int, vector<pair<int, int>>> src = g.getAdjList();
+		for (auto& row : src) {
+			vector<Arc>& arcs = this->adj[row.first];
+			arcs.reserve(row.second.size());
+			for (auto& p : row.second) arcs.push_back(makeArc(p.first, (WeightArg)p.second));
+		}
+	}
+
+	//  Graph;       int
+	Graph toGraph() const {
+		map<int, vector<pair<int, int>>> dst;
+		for (auto& row : this->adj) {
+			vector<pair<int, int>>& arcs = dst[toInt(row.first, "vertex name does not fit into int")];
+			arcs.reserve(row.second.size());
+			for (auto& a : row.second) {
+				int w = 0;
+				if constexpr (weighted) {
+					if (a.weight != (Weight)(long long)a.weight) throw OperationErr("weight is not integer");
+					w = toInt(a.weight, "weight does not fit into int");
+				}
+				arcs.push_back(make_pair(toInt(a.to, "vertex name does not fit into int"), w));
+			}
+		}
+		return Graph(Directed, weighted, move(dst));
+	}
+
+	int vertexCount() const { return (int)this->adj.size(); }
+	long long arcCount() const {
+		long long m = 0;
+		for (auto& row : this->adj) m += row.second.size();
+		return m;
+	}
+	bool hasVertex(VertexId v) const { return this->adj.find(v) != this->adj.end(); }
+	const map<VertexId, vector<Arc>>& adjList() const { return this->adj; } //        
+
+	void addVertex(VertexId v) {
+		if (!this->adj.emplace(v, vector<Arc>()).second)
+			throw OperationErr("vertex with such name already exists");
+		this->dropDense();
+	}
+
+	void addEdge(VertexId f, VertexId s) {
+		static_assert(!weighted, "specify weight of the edge");
+		this->insert(f, s, WeightArg());
+	}
+
+	void addEdge(VertexId f, VertexId s, WeightArg w) {
+		static_assert(weighted, "graph is unweighted");
+		this->insert(f, s, w);
+	}
+
+	void deleteVertex(VertexId v) {
+		if (!this->adj.erase(v)) throw OperationErr("there is no such vertex");
+		this->dropDense();
+		for (auto& row : this->adj)
+			row.second.erase(remove_if(row.second.begin(), row.second.end(), [v](const Arc& a) { return a.to == v; }), row.second.end());
+	}
+
+	void deleteEdge(VertexId f, VertexId s) {
+		static_assert(!weighted, "specify weight of the edge");
+		this->erase(f, s, WeightArg());
+	}
+
+	void deleteEdge(VertexId f, VertexId s, WeightArg w) {
+		static_assert(weighted, "graph is unweighted");
+		this->erase(f, s, w);
+	}
+
+	//  ;       ,    
+	vector<Edge> edgeList() const {
+		vector<Edge> edges;
+		for (auto& row : this->adj) {
+			int loops = 0;
+			for (auto& a : row.second) {
+				//       
+				if (!Directed && (a.to < row.first || (a.to == row.first && loops++ % 2))) continue;
+				if constexpr (weighted) edges.push_back(Edge{ row.first, a.to, a.weight });
+				else edges.push_back(Edge{ row.first, a.to });
+			}
+		}
+		return edges;
+	}
+
+	//       ,    
+	int components() const {
+		shared_ptr<const Dense> g = this->dense(false);
+		int n = g->size(), k = 0;
+		vector<int> order, st;
+		vector<char> seen(n, 0);
+		if constexpr (Directed) {
+			// :    DFS,       
+			vector<pair<int, int>> dfs;
+			for (int s = 0; s < n; ++s) {
+				if (seen[s]) continue;
+				seen[s] = 1;
+				dfs.push_back(make_pair(s, g->offset[s]));
+				while (!dfs.empty()) {
+					int v = dfs.back().first;
+					if (dfs.back().second < g->offset[v + 1]) {
+						int u = g->target[dfs.back().second++];
+						if (!seen[u]) {
+							seen[u] = 1;
+							dfs.push_back(make_pair(u, g->offset[u]));
+						}
+					}
+					else {
+						order.push_back(v);
+						dfs.pop_back();
+					}
+				}
+			}
+			g = this->dense(true);
+			reverse(order.begin(), order.end());
+			fill(seen.begin(), seen.end(), 0);
+		}
+		else {
+			for (int v = 0; v < n; ++v) order.push_back(v);
+		}
+		for (int r : order) {
+			if (seen[r]) continue;
+			k++;
+			seen[r] = 1;
+			st.push_back(r);
+			while (!st.empty()) {
+				int v = st.back(); st.pop_back();
+				for (int a = g->offset[v]; a < g->offset[v + 1]; ++a)
+					if (!seen[g->target[a]]) {
+						seen[g->target[a]] = 1;
+						st.push_back(g->target[a]);
+					}
+			}
+		}
+		return k;
+	}
+
+	//      u  v:      ,   
+	pair<Distance, vector<VertexId>> shortestPath(VertexId u, VertexId v) const {
+		if (!this->hasVertex(u) || !this->hasVertex(v)) throw OperationErr("u or v do no exist in graph");
+		shared_ptr<const Dense> g = this->dense(false);
+		int n = g->size(), s = g->index(u), t = g->index(v);
+		const Distance none = numeric_limits<Distance>::max();
+		vector<Distance> dist(n, none);
+		vector<int> parent(n, -1);
+		dist[s] = 0;
+		if constexpr (weighted) {
+			typedef pair<Distance, int> Item;
+			priority_queue<Item, vector<Item>, greater<Item>> heap;
+			heap.push(make_pair(Distance(0), s));
+			while (!heap.empty()) {
+				Item top = heap.top(); heap.pop();
+				int x = top.second;
+				if (top.first > dist[x]) continue;
+				if (x == t) break;
+				for (int a = g->offset[x]; a < g->offset[x + 1]; ++a) {
+					if (g->length[a] < 0) throw OperationErr("Graph has negative weights");
+					int y = g->target[a];
+					if (dist[x] + g->length[a] < dist[y]) {
+						dist[y] = dist[x] + g->length[a];
+						parent[y] = x;
+						heap.push(make_pair(dist[y], y));
+					}
+				}
+			}
+		}
+		else {
+			vector<int> q(1, s);
+			for (size_t i = 0; i < q.size() && dist[t] == none; ++i)
+				for (int a = g->offset[q[i]]; a < g->offset[q[i] + 1]; ++a) {
+					int y = g->target[a];
+					if (dist[y] == none) {
+						dist[y] = dist[q[i]] + 1;
+						parent[y] = q[i];
+						q.push_back(y);
+					}
+				}
+		}
+		if (dist[t] == none) throw OperationErr("no way from u to v");
+		vector<VertexId> path;
+		for (int x = t; x >= 0; x = parent[x]) path.push_back(g->ids[x]);
+		reverse(path.begin(), path.end());
+		return make_pair(dist[t], path);
+	}
+
+	//      ;   -   
+	BasicGraph spanningForest() const {
+		static_assert(!Directed, "Graph has to be undirected");
+		vector<Edge> edges = this->edgeList();
+		if constexpr (weighted)
+			stable_sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) { return a.weight < b.weight; });
+		vector<VertexId> ids;
+		for (auto& row : this->adj) ids.push_back(row.first);
+		vector<int> tree(ids.size());
+		for (int i = 0; i < (int)tree.size(); ++i) tree[i] = i;
+		auto root = [&](VertexId v) {
+			int x = lower_bound(ids.begin(), ids.end(), v) - ids.begin();
+			while (tree[x] != x) x = tree[x] = tree[tree[x]];
+			return x;
+		};
+		BasicGraph forest;
+		for (VertexId v : ids) forest.adj[v];
+		for (auto& e : edges) {
+			int a = root(e.from), b = root(e.to);
+			if (a == b) continue;
+			tree[b] = a;
+			if constexpr (weighted) forest.insert(e.from, e.to, e.weight);
+			else forest.insert(e.from, e.to, WeightArg());
+		}
+		return forest;
+	}
+
+private:
+	//        ; length     
+	struct Dense
+	{
+		vector<VertexId> ids;
+		vector<int> offset, target;
+		vector<Distance> length;
+
+		int size() const { return (int)this->ids.size(); }
+		int index(VertexId v) const { return (int)(lower_bound(this->ids.begin(), this->ids.end(), v) - this->ids.begin()); }
+	};
+
+	//           
+	shared_ptr<const Dense> dense(bool transposed) const {
+		shared_ptr<const Dense> g = atomic_load(&this->cache[transposed]);
+		if (!g) {
+			g = make_shared<const Dense>(this->buildDense(transposed));
+			atomic_store(&this->cache[transposed], g);
+		}
+		return g;
+	}
+
+	void dropDense() {
+		this->cache[0].reset();
+		this->cache[1].reset();
+	}
+
+	Dense buildDense(bool transposed) const {
+		Dense g;
+		for (auto& row : this->adj) g.ids.push_back(row.first);
+		int n = g.size();
+		g.offset.assign(n + 1, 0);
+		int i = 0;
+		for (auto& row : this->adj) {
+			for (auto& a : row.second) {
+				if (!this->hasVertex(a.to)) continue;
+				g.offset[(transposed ? g.index(a.to) : i) + 1]++;
+			}
+			i++;
+		}
+		for (int v = 0; v < n; ++v) g.offset[v + 1] += g.offset[v];
+		g.target.resize(g.offset[n]);
+		if constexpr (weighted) g.length.resize(g.offset[n]);
+		vector<int> pos(g.offset.begin(), g.offset.end() - 1);
+		i = 0;
+		for (auto& row : this->adj) {
+			for (auto& a : row.second) {
+				if (!this->hasVertex(a.to)) continue;
+				int to = g.index(a.to);
+				int p = pos[transposed ? to : i]++;
+				g.target[p] = transposed ? i : to;
+				if constexpr (weighted) g.length[p] = a.weight;
+			}
+			i++;
+		}
+		return g;
+	}
+
+	static Arc makeArc(VertexId to, WeightArg w) {
+		if constexpr (weighted) return Arc{ to, w };
+		else return Arc{ to };
+	}
+
+	static bool matches(const Arc& a, VertexId to, WeightArg w) {
+		if constexpr (weighted) return a.to == to && a.weight == w;
+		else return a.to == to;
+	}
+
+	template<class T>
+	static int toInt(T x, const char* error) {
+		if (x < numeric_limits<int>::min() || x > numeric_limits<int>::max()) throw OperationErr(error);
+		return (int)x;
+	}
+
+	void insert(VertexId f, VertexId s, WeightArg w) {
+		auto fi = this->adj.find(f), si = this->adj.find(s);
+		if (fi == this->adj.end() || si == this->adj.end()) throw OperationErr("there is no such vertex(s)");
+		for (auto& a : fi->second)
+			if (matches(a, s, w)) throw OperationErr("such edge already exists");
+		fi->second.push_back(makeArc(s, w));
+		if (!Directed) si->second.push_back(makeArc(f, w));
+		this->dropDense();
+	}
+
+	void erase(VertexId f, VertexId s, WeightArg w) {
+		auto fi = this->adj.find(f), si = this->adj.find(s);
+		if (fi == this->adj.end() || si == this->adj.end()) throw OperationErr("there is no such vertex(s)");
+		auto it = find_if(fi->second.begin(), fi->second.end(), [&](const Arc& a) { return matches(a, s, w); });
+		if (it == fi->second.end()) throw OperationErr("there is no such edge");
+		fi->second.erase(it);
+		if (!Directed) {
+			it = find_if(si->second.begin(), si->second.end(), [&](const Arc& a) { return matches(a, f, w); });
+			si->second.erase(it);
+		}
+		this->dropDense();
+	}
+
+	map<VertexId, vector<Arc>> adj;
+	mutable shared_ptr<const Dense> cache[2]; //     
+};
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include "Bfs.h"
+#include "Stats.h"
+
+namespace {
+	//      Beamer et al.
+	const int alpha = 14, beta = 24;
+}
+
+vector<int> hopBfs(const Csr& g, const Csr& inv, int source, int target, Exec policy) {
+	int n = g.size();
+	int words = (n + 63) / 64;
+	vector<atomic<int>> dist(n);
+	runFor(policy, 0, n, [&](int b, int e) {
+		for (int i = b; i < e; ++i) dist[i] = -1;
+	}, 4096);
+	dist[source] = 0;
+
+	vector<int> frontier(1, source), next;
+	vector<uint64_t> front(words, 0), nextBits(words, 0);
+	bool bottomUp = false;
+	int frontSize = 1;
+	long long frontArcs = g.degree(source); //   
+	long long restArcs = g.arcs() - frontArcs; //      
+	mutex nextM;
+
+	for (int level = 0; frontSize > 0; ++level) {
+		if (target >= 0 && dist[target] >= 0) break;
+
+		if (!bottomUp && frontArcs > restArcs / alpha) {
+			bottomUp = true;
+			fill(front.begin(), front.end(), 0);
+			for (int v : frontier) front[v >> 6] |= 1ULL << (v & 63);
+		}
+		else if (bottomUp && frontSize < n / beta) {
+			bottomUp = false;
+			frontier.clear();
+			for (int w = 0; w < words; ++w)
+				for (int bit = 0; bit < 64 && front[w] >> bit; ++bit)
+					if (front[w] >> bit & 1) frontier.push_back(w * 64 + bit);
+		}
+
+		atomic<int> found(0);
+		atomic<long long> arcsSum(0);
+		if (!bottomUp) {
+			next.clear();
+			runFor(policy, 0, frontier.size(), [&](int b, int e) {
+				vector<int> local;
+				long long s = 0;
+				for (int i = b; i < e; ++i) {
+					int v = frontier[i];
+					GRAPH_STATS_ADD(relaxed, g.degree(v));
+					for (int a = g.offset[v]; a < g.offset[v + 1]; ++a) {
+						int u = g.target[a], none = -1;
+						if (dist[u] == -1 && dist[u].compare_exchange_strong(none, level + 1)) {
+							local.push_back(u);
+							s += g.degree(u);
+						}
+					}
+				}
+				lock_guard<mutex> lk(nextM);
+				next.insert(next.end(), local.begin(), local.end());
+				arcsSum += s;
+			}, 64);
+			frontier.swap(next);
+			found = frontier.size();
+		}
+		else {
+			//        ,   
+			runFor(policy, 0, words, [&](int b, int e) {
+				int c = 0;
+				long long s = 0;
+				for (int w = b; w < e; ++w) {
+					uint64_t bits = 0;
+					for (int v = w * 64; v < min(n, w * 64 + 64); ++v) {
+						if (dist[v] != -1) continue;
+						GRAPH_STATS_ADD(relaxed, inv.degree(v)); //    
+						for (int a = inv.offset[v]; a < inv.offset[v + 1]; ++a) {
+							int u = inv.target[a];
+							if (front[u >> 6] >> (u & 63) & 1) {
+								dist[v] = level + 1;
+								bits |= 1ULL << (v & 63);
+								c++;
+								s += g.degree(v);
+								break;
+							}
+						}
+					}
+					nextBits[w] = bits;
+				}
+				found += c;
+				arcsSum += s;
+			}, 16);
+			front.swap(nextBits);
+		}
+		frontSize = found;
+		GRAPH_STATS_ADD(visited, frontSize);
+		restArcs -= arcsSum;
+		frontArcs = arcsSum;
+	}
+	return vector<int>(dist.begin(), dist.end());
+}
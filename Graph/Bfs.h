@@ -0,0 +1,13 @@
+#include <vector>
+#include "Csr.h"
+#include "Executor.h"
+
+using namespace std;
+
+#pragma once
+/*       (Beamer):
+  ,     (top-down),
+   -          (bottom-up).
+g - , inv -   .    , -1 - .
+ target >= 0,  ,   target  */
+vector<int> hopBfs(const Csr& g, const Csr& inv, int source, int target = -1, Exec policy = Exec::sequential);
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include "Compressed.h"
+#include "Graph.h"
+#include "Search.h"
+#include "Stats.h"
+
+CompressedGraph::CompressedGraph(const string fileName, bool compressWeights) {
+	GRAPH_STATS_SCOPE("CompressedGraph::read");
+	ifstream in(fileName);
+	if (!in.is_open()) throw Err();
+	string s;
+	getline(in, s);
+	if (s == "directed") this->directed = true;
+	else if (s == "undirected") this->directed = false;
+	else throw FileFormatErr("graph type not specified: directed/undirected");
+	getline(in, s);
+	if (s == "weighted") this->weighted = true;
+	else if (s == "unweighted") this->weighted = false;
+	else throw FileFormatErr("graph type not specified: weighted/unweighted");
+	this->packedWeights = compressWeights;
+	this->arcCount = 0;
+	this->negative = false;
+
+	//   -  ,      
+	streampos rows = in.tellg();
+	try {
+		while (getline(in, s)) {
+			int pos = s.find(':');
+			this->ids.push_back(stoi(s.substr(0, pos)));
+		}
+	}
+	catch (...) {
+		throw FileFormatErr("incorrect adjList format");
+	}
+	sort(this->ids.begin(), this->ids.end());
+	this->ids.erase(unique(this->ids.begin(), this->ids.end()), this->ids.end());
+	this->ids.shrink_to_fit();
+
+	//   - ;     ,   Graph
+	this->start.assign(this->ids.size(), 0);
+	in.clear();
+	in.seekg(rows);
+	vector<pair<int, int>> adj, row;
+	vector<char> seen(this->ids.size(), 0);
+	bool replaced = false;
+	int v;
+	try {
+		while (getline(in, s)) {
+			adj.clear();
+			parseAdjLine(s, this->weighted, v, adj);
+			row.clear();
+			for (auto& p : adj) {
+				int x = this->index(p.first);
+				if (x >= 0) row.push_back(make_pair(x, p.second));
+			}
+			int i = this->index(v);
+			if (seen[i]) {
+				this->arcCount -= this->degree(i);
+				replaced = true;
+			}
+			seen[i] = 1;
+			this->encodeRow(i, row);
+		}
+	}
+	catch (...) {
+		throw FileFormatErr("incorrect adjList format");
+	}
+	if (replaced) this->dropReplacedRows();
+	this->data.shrink_to_fit();
+	GRAPH_STATS_ADD(visited, this->size());
+	GRAPH_STATS_ADD(relaxed, this->arcCount);
+	GRAPH_STATS_ADD(bytes, this->bytes());
+}
+
+CompressedGraph::CompressedGraph(const Csr& g, bool directed, bool weighted, bool compressWeights) {
+	GRAPH_STATS_SCOPE("CompressedGraph::build");
+	this->directed = directed;
+	this->weighted = weighted;
+	this->packedWeights = compressWeights;
+	this->arcCount = 0;
+	this->negative = false;
+	this->ids = g.ids;
+	this->start.assign(g.size(), 0);
+	vector<pair<int, int>> row;
+	for (int i = 0; i < g.size(); ++i) {
+		row.clear();
+		for (int a = g.offset[i]; a < g.offset[i + 1]; ++a) row.push_back(make_pair(g.target[a], g.weight[a]));
+		this->encodeRow(i, row);
+	}
+	this->data.shrink_to_fit();
+	GRAPH_STATS_ADD(visited, this->size());
+	GRAPH_STATS_ADD(relaxed, this->arcCount);
+	GRAPH_STATS_ADD(bytes, this->bytes());
+}
+
+void CompressedGraph::writeVarint(uint64_t x) {
+	while (x >= 0x80) {
+		this->data.push_back((uint8_t)(x | 0x80));
+		x >>= 7;
+	}
+	this->data.push_back((uint8_t)x);
+}
+
+void CompressedGraph::encodeRow(int v, vector<pair<int, int>>& row) {
+	sort(row.begin(), row.end());
+	this->start[v] = this->data.size();
+	this->writeVarint(row.size());
+	long long prev = v;
+	for (size_t i = 0; i < row.size(); ++i) {
+		long long d = row[i].first - prev;
+		//     ,  - 
+		this->writeVarint(i ? (uint64_t)d : ((uint64_t)d << 1) ^ (uint64_t)(d >> 63));
+		prev = row[i].first;
+		if (!this->weighted) continue;
+		int w = row[i].second;
+		this->negative = this->negative || w < 0;
+		if (this->packedWeights) this->writeVarint(((uint64_t)(long long)w << 1) ^ (uint64_t)((long long)w >> 63));
+		else {
+			uint8_t raw[sizeof(int)];
+			memcpy(raw, &w, sizeof(int));
+			this->data.insert(this->data.end(), raw, raw + sizeof(int));
+		}
+	}
+	this->arcCount += row.size();
+}
+
+const uint8_t* CompressedGraph::rowEnd(int v) const {
+	const uint8_t* p = this->data.data() + this->start[v];
+	for (uint64_t left = readVarint(p); left; --left) {
+		readVarint(p);
+		if (!this->weighted) continue;
+		if (this->packedWeights) readVarint(p);
+		else p += sizeof(int);
+	}
+	return p;
+}
+
+void CompressedGraph::dropReplacedRows() {
+	//  data    ,   ;      
+	vector<uint8_t> kept;
+	kept.reserve(this->data.size());
+	this->negative = false;
+	for (int v = 0; v < this->size(); ++v) {
+		const uint8_t* p = this->data.data() + this->start[v], *end = this->rowEnd(v);
+		if (this->weighted) this->forEachArc(v, [&](int, int w) { this->negative = this->negative || w < 0; });
+		this->start[v] = kept.size();
+		kept.insert(kept.end(), p, end);
+	}
+	this->data.swap(kept);
+}
+
+int CompressedGraph::index(int v) const {
+	auto it = lower_bound(this->ids.begin(), this->ids.end(), v);
+	if (it == this->ids.end() || *it != v) return -1;
+	return (int)(it - this->ids.begin());
+}
+
+int CompressedGraph::degree(int v) const {
+	const uint8_t* p = this->data.data() + this->start[v];
+	return (int)readVarint(p);
+}
+
+size_t CompressedGraph::bytes() const {
+	return this->ids.capacity() * sizeof(int) + this->start.capacity() * sizeof(uint64_t) + this->data.capacity();
+}
+
+int CompressedGraph::amountOfConnectedParts() const {
+	GRAPH_STATS_SCOPE("CompressedGraph::amountOfConnectedParts");
+	if (!this->directed) throw OperationErr("graph is not directed");
+	int n = this->size();
+
+	//   :        ,    
+	vector<int> order(n, -1), low(n);
+	vector<char> onStack(n, 0);
+	vector<int> st;
+	vector<pair<int, Cursor>> frames;
+	int timer = 0, k = 0;
+	for (int s = 0; s < n; ++s) {
+		if (order[s] >= 0) continue;
+		order[s] = low[s] = timer++;
+		st.push_back(s);
+		onStack[s] = 1;
+		frames.push_back(make_pair(s, Cursor(*this, s)));
+		while (!frames.empty()) {
+			int v = frames.back().first, x, w;
+			if (frames.back().second.next(x, w)) {
+				GRAPH_STATS_ADD(relaxed, 1);
+				if (order[x] < 0) {
+					order[x] = low[x] = timer++;
+					st.push_back(x);
+					onStack[x] = 1;
+					frames.push_back(make_pair(x, Cursor(*this, x)));
+				}
+				else if (onStack[x]) low[v] = min(low[v], order[x]);
+				continue;
+			}
+			GRAPH_STATS_ADD(visited, 1);
+			frames.pop_back();
+			if (!frames.empty()) low[frames.back().first] = min(low[frames.back().first], low[v]);
+			if (low[v] != order[v]) continue;
+			int y;
+			do {
+				y = st.back();
+				st.pop_back();
+				onStack[y] = 0;
+			} while (y != v);
+			k++;
+		}
+	}
+	return k;
+}
+
+vector<int> CompressedGraph::hopDistances(int u) const {
+	GRAPH_STATS_SCOPE("CompressedGraph::hopDistances");
+	int s = this->index(u);
+	if (s < 0) throw OperationErr("there is no such vertex");
+	vector<int> dist(this->size(), -1), frontier(1, s), next;
+	dist[s] = 0;
+	for (int level = 1; !frontier.empty(); ++level) {
+		next.clear();
+		for (int v : frontier) {
+			GRAPH_STATS_ADD(visited, 1);
+			GRAPH_STATS_ADD(relaxed, this->degree(v));
+			this->forEachArc(v, [&](int x, int) {
+				if (dist[x] < 0) {
+					dist[x] = level;
+					next.push_back(x);
+				}
+			});
+		}
+		frontier.swap(next);
+	}
+	return dist;
+}
+
+pair<int, int> CompressedGraph::shortestWays(int u, int v1, int v2) const {
+	GRAPH_STATS_SCOPE("CompressedGraph::shortestWays");
+	if (!this->weighted) throw OperationErr("Graph has to be weighted");
+	int s = this->index(u), t1 = this->index(v1), t2 = this->index(v2);
+	if (s < 0 || t1 < 0 || t2 < 0) throw OperationErr("u, v1 or v2 do no exist in graph");
+	//       ,        
+	if (this->negative) throw OperationErr("Graph has negative weights");
+
+	typedef pair<long long, int> Item;
+	vector<long long> dist(this->size(), unreachable);
+	vector<Item> heap;
+	dist[s] = 0;
+	heap.push_back(make_pair(0LL, s));
+	bool seen1 = false, seen2 = false;
+	while (!heap.empty()) {
+		pop_heap(heap.begin(), heap.end(), greater<Item>());
+		Item top = heap.back(); heap.pop_back();
+		int v = top.second;
+		if (top.first > dist[v]) continue;
+		seen1 = seen1 || v == t1;
+		seen2 = seen2 || v == t2;
+		if (seen1 && seen2) break;
+		GRAPH_STATS_ADD(visited, 1);
+		GRAPH_STATS_ADD(relaxed, this->degree(v));
+		this->forEachArc(v, [&](int x, int w) {
+			if (dist[v] + w < dist[x]) {
+				dist[x] = dist[v] + w;
+				heap.push_back(make_pair(dist[x], x));
+				push_heap(heap.begin(), heap.end(), greater<Item>());
+			}
+		});
+	}
+
+	if (dist[t1] == unreachable) throw OperationErr("no way from u to v1");
+	if (dist[t2] == unreachable) throw OperationErr("no way from u to v2");
+	return make_pair((int)dist[t1], (int)dist[t2]);
+}
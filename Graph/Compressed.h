@@ -0,0 +1,98 @@
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Csr.h"
+
+using namespace std;
+
+#pragma once
+/*      ,  ,       Graph.
+  0..n-1   ,   Csr.   -   data  start[v]:
+ ,       .  :     v,  -
+  ,   varint (7   ),       .
+ - varint   (zigzag) ,    , 4   .
+  ,    ,   */
+class CompressedGraph
+{
+public:
+	//      :  ,    ,    
+	CompressedGraph(const string fileName, bool compressWeights = true);
+	CompressedGraph(const Csr& g, bool directed, bool weighted, bool compressWeights = true);
+
+	//    ;  -    
+	class Cursor
+	{
+	public:
+		Cursor(const CompressedGraph& g, int v) : g(&g), p(g.data.data() + g.start[v]), prev(v), first(true) {
+			this->left = readVarint(this->p);
+		}
+
+		bool next(int& to, int& weight) {
+			if (!this->left) return false;
+			this->left--;
+			uint64_t d = readVarint(this->p);
+			this->prev += this->first ? unzigzag(d) : (long long)d;
+			this->first = false;
+			to = (int)this->prev;
+			weight = 0;
+			if (this->g->weighted) {
+				if (this->g->packedWeights) weight = (int)unzigzag(readVarint(this->p));
+				else {
+					memcpy(&weight, this->p, sizeof(int));
+					this->p += sizeof(int);
+				}
+			}
+			return true;
+		}
+
+	private:
+		const CompressedGraph* g;
+		const uint8_t* p;
+		uint64_t left;
+		long long prev;
+		bool first;
+	};
+
+	template<class Visit>
+	void forEachArc(int v, Visit visit) const { // visit(, )
+		Cursor c(*this, v);
+		int to, w;
+		while (c.next(to, w)) visit(to, w);
+	}
+
+	bool isDirected() const { return this->directed; }
+	bool isWeighted() const { return this->weighted; }
+	int size() const { return (int)this->ids.size(); }
+	long long arcs() const { return this->arcCount; }
+	int index(int v) const; //    , -1   
+	int name(int i) const { return this->ids[i]; }
+	int degree(int v) const;
+	size_t bytes() const; //  
+
+	int amountOfConnectedParts() const; //      ()
+	vector<int> hopDistances(int u) const; //     u   , -1 - 
+	pair<int, int> shortestWays(int u, int v1, int v2) const; //     u  v1  v2,  
+
+private:
+	static uint64_t readVarint(const uint8_t*& p) {
+		uint64_t x = 0;
+		for (int shift = 0;; shift += 7) {
+			uint8_t b = *p++;
+			x |= (uint64_t)(b & 0x7f) << shift;
+			if (!(b & 0x80)) return x;
+		}
+	}
+	static long long unzigzag(uint64_t x) { return (long long)(x >> 1) ^ -(long long)(x & 1); }
+	void writeVarint(uint64_t x);
+	void encodeRow(int v, vector<pair<int, int>>& row); //        data
+	const uint8_t* rowEnd(int v) const; //     data
+	void dropReplacedRows(); //   data ,      
+
+	vector<int> ids; //    
+	vector<uint64_t> start; //     data
+	vector<uint8_t> data;
+	long long arcCount;
+	bool directed, weighted, packedWeights, negative;
+};
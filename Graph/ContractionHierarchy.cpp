@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <queue>
+#include "ContractionHierarchy.h"
+#include "Arena.h"
+
+namespace {
+	typedef pair<long long, int> Item;
+	//      :      ,  
+	const int witnessLimit = 500;
+
+	struct Link
+	{
+		int to, weight, middle;
+	};
+
+	//    ,    
+	struct Scratch
+	{
+		vector<long long> dist;
+		vector<int> touched;
+		vector<Item> heap;
+	};
+
+	//     
+	struct Contractor
+	{
+		vector<vector<Link>> out, in;
+		vector<char> contracted;
+		vector<int> deleted; //    
+		vector<int> level; //   :  1 ,    
+
+		//   u -> x;      . 1,   
+		int link(int u, int x, int w, int middle) {
+			for (auto& l : this->out[u])
+				if (l.to == x) {
+					if (w < l.weight) {
+						l.weight = w; l.middle = middle;
+						for (auto& r : this->in[x])
+							if (r.to == u) { r.weight = w; r.middle = middle; }
+					}
+					return 0;
+				}
+			this->out[u].push_back({ x, w, middle });
+			this->in[x].push_back({ u, w, middle });
+			return 1;
+		}
+
+		//   u   v,     limit
+		void witness(int u, int v, long long limit, Scratch& sc) {
+			for (int x : sc.touched) sc.dist[x] = unreachable;
+			sc.touched.clear();
+			sc.heap.clear();
+			sc.dist[u] = 0; sc.touched.push_back(u);
+			sc.heap.push_back(make_pair(0LL, u));
+			int settled = 0;
+			while (!sc.heap.empty() && settled < witnessLimit) {
+				pop_heap(sc.heap.begin(), sc.heap.end(), greater<Item>());
+				Item top = sc.heap.back(); sc.heap.pop_back();
+				if (top.first > sc.dist[top.second]) continue;
+				if (top.first > limit) break;
+				settled++;
+				for (auto& l : this->out[top.second]) {
+					if (l.to == v) continue;
+					long long d = top.first + l.weight;
+					if (d < sc.dist[l.to]) {
+						if (sc.dist[l.to] == unreachable) sc.touched.push_back(l.to);
+						sc.dist[l.to] = d;
+						sc.heap.push_back(make_pair(d, l.to));
+						push_heap(sc.heap.begin(), sc.heap.end(), greater<Item>());
+					}
+				}
+			}
+		}
+
+		// ,    v;  apply    
+		int contract(int v, bool apply, Scratch& sc) {
+			int added = 0;
+			long long maxOut = 0;
+			for (auto& l : this->out[v]) maxOut = max(maxOut, (long long)l.weight);
+			vector<Link> in = this->in[v], out = this->out[v];
+			for (auto& a : in) {
+				this->witness(a.to, v, a.weight + maxOut, sc);
+				for (auto& b : out) {
+					if (b.to == a.to) continue;
+					long long w = (long long)a.weight + b.weight;
+					if (sc.dist[b.to] <= w) continue;
+					//     int,       
+					if (w > numeric_limits<int>::max()) throw OperationErr("shortcut weight does not fit into int");
+					added += apply ? this->link(a.to, b.to, (int)w, v) : 1;
+				}
+			}
+			return added;
+		}
+
+		int priority(int v, Scratch& sc) {
+			int difference = this->contract(v, false, sc) - (int)this->in[v].size() - (int)this->out[v].size();
+			return 2 * difference + this->deleted[v] + this->level[v];
+		}
+	};
+
+	template <class T>
+	void writeVector(ofstream& out, const vector<T>& v) {
+		long long n = v.size();
+		out.write((const char*)&n, sizeof(n));
+		if (n) out.write((const char*)v.data(), n * sizeof(T));
+	}
+
+	template <class T>
+	void readVector(ifstream& in, vector<T>& v) {
+		long long n = 0;
+		in.read((char*)&n, sizeof(n));
+		//     ,        
+		streampos at = in.tellg();
+		in.seekg(0, ios::end);
+		long long left = (long long)(in.tellg() - at);
+		in.seekg(at);
+		if (!in || n < 0 || n > left / (long long)sizeof(T)) throw FileFormatErr("broken contraction hierarchy");
+		v.resize(n);
+		if (n) in.read((char*)v.data(), n * sizeof(T));
+		if (!in) throw FileFormatErr("broken contraction hierarchy");
+	}
+
+	const char magic[] = "contraction hierarchy v1";
+}
+
+ContractionHierarchy::ContractionHierarchy(Graph& g, Exec policy) : shortcutCount(0), meet(-1) {
+	GRAPH_STATS_SCOPE("ContractionHierarchy");
+	if (!g.isWeighted()) throw OperationErr("Graph has to be weighted");
+	shared_ptr<const Csr> cPtr = g.getCsr(policy);
+	const Csr& c = *cPtr;
+	if (c.negative) throw OperationErr("Graph has negative weights");
+	int n = c.size();
+	this->ids = c.ids;
+
+	Contractor cg;
+	cg.out.resize(n); cg.in.resize(n);
+	cg.contracted.assign(n, 0);
+	cg.deleted.assign(n, 0);
+	cg.level.assign(n, 0);
+	for (int v = 0; v < n; ++v)
+		for (int a = c.offset[v]; a < c.offset[v + 1]; ++a)
+			if (c.target[a] != v) cg.link(v, c.target[a], c.weight[a], -1);
+
+	//   ,   
+	vector<int> prio(n);
+	runFor(policy, 0, n, [&](int b, int e) {
+		Scratch sc;
+		sc.dist.assign(n, unreachable);
+		for (int v = b; v < e; ++v) prio[v] = cg.priority(v, sc);
+	}, 64);
+	priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> heap;
+	for (int v = 0; v < n; ++v) heap.push(make_pair(prio[v], v));
+
+	Scratch sc;
+	sc.dist.assign(n, unreachable);
+	//       ,    
+	Arena arena;
+	ArenaAllocator<Link> alloc(arena);
+	vector<ArenaVector<Link>> upList(n, ArenaVector<Link>(alloc)), downList(n, ArenaVector<Link>(alloc));
+	this->rank.assign(n, 0);
+	int order = 0;
+	while (!heap.empty()) {
+		int v = heap.top().second, p = heap.top().first; heap.pop();
+		if (cg.contracted[v] || p != prio[v]) continue;
+		//  :   ,    
+		p = cg.priority(v, sc);
+		if (!heap.empty() && p > heap.top().first) {
+			prio[v] = p;
+			heap.push(make_pair(p, v));
+			continue;
+		}
+		this->shortcutCount += cg.contract(v, true, sc);
+		GRAPH_STATS_ADD(visited, 1);
+		this->rank[v] = order++;
+		upList[v].assign(cg.out[v].begin(), cg.out[v].end());
+		downList[v].assign(cg.in[v].begin(), cg.in[v].end());
+		for (auto& l : cg.out[v]) {
+			auto& in = cg.in[l.to];
+			in.erase(remove_if(in.begin(), in.end(), [v](const Link& r) { return r.to == v; }), in.end());
+			cg.deleted[l.to]++;
+			cg.level[l.to] = max(cg.level[l.to], cg.level[v] + 1);
+		}
+		for (auto& l : cg.in[v]) {
+			auto& out = cg.out[l.to];
+			out.erase(remove_if(out.begin(), out.end(), [v](const Link& r) { return r.to == v; }), out.end());
+			cg.deleted[l.to]++;
+			cg.level[l.to] = max(cg.level[l.to], cg.level[v] + 1);
+		}
+		cg.contracted[v] = 1;
+		//    :    
+		vector<int> around;
+		for (auto& l : cg.out[v]) around.push_back(l.to);
+		for (auto& l : cg.in[v]) around.push_back(l.to);
+		vector<Link>().swap(cg.out[v]);
+		vector<Link>().swap(cg.in[v]);
+		sort(around.begin(), around.end());
+		around.erase(unique(around.begin(), around.end()), around.end());
+		for (int u : around) {
+			prio[u] = cg.priority(u, sc);
+			heap.push(make_pair(prio[u], u));
+		}
+	}
+
+	this->upOffset.assign(n + 1, 0);
+	this->downOffset.assign(n + 1, 0);
+	for (int v = 0; v < n; ++v) {
+		this->upOffset[v + 1] = this->upOffset[v] + upList[v].size();
+		this->downOffset[v + 1] = this->downOffset[v] + downList[v].size();
+		for (auto& l : upList[v]) this->up.push_back({ l.to, l.weight, l.middle });
+		for (auto& l : downList[v]) this->down.push_back({ l.to, l.weight, l.middle });
+	}
+	for (int d = 0; d < 2; ++d) {
+		this->dist[d].assign(n, unreachable);
+		this->parent[d].assign(n, -1);
+	}
+	GRAPH_STATS_ADD(bytes, (this->up.size() + this->down.size()) * sizeof(Arc));
+}
+
+ContractionHierarchy::ContractionHierarchy(const string fileName) : shortcutCount(0), meet(-1) {
+	ifstream in(fileName, ios::binary);
+	if (!in.is_open()) throw FileNameErr(fileName);
+	char head[sizeof(magic)] = {};
+	in.read(head, sizeof(magic));
+	if (!in || memcmp(head, magic, sizeof(magic)) != 0) throw FileFormatErr("not a contraction hierarchy");
+	in.read((char*)&this->shortcutCount, sizeof(this->shortcutCount));
+	readVector(in, this->ids);
+	readVector(in, this->rank);
+	readVector(in, this->upOffset);
+	readVector(in, this->up);
+	readVector(in, this->downOffset);
+	readVector(in, this->down);
+	size_t n = this->ids.size();
+	if (this->rank.size() != n || this->upOffset.size() != n + 1 || this->downOffset.size() != n + 1)
+		throw FileFormatErr("broken contraction hierarchy");
+	//         ,     
+	auto validArcs = [n](const vector<int>& offset, const vector<Arc>& arcs) {
+		if (offset[0] != 0 || (size_t)offset[n] != arcs.size()) return false;
+		for (size_t v = 0; v < n; ++v)
+			if (offset[v] > offset[v + 1]) return false;
+		for (auto& a : arcs)
+			if (a.to < 0 || (size_t)a.to >= n || a.middle < -1 || a.middle >= (long long)n) return false;
+		return true;
+	};
+	if (!validArcs(this->upOffset, this->up) || !validArcs(this->downOffset, this->down))
+		throw FileFormatErr("broken contraction hierarchy");
+	for (int d = 0; d < 2; ++d) {
+		this->dist[d].assign(n, unreachable);
+		this->parent[d].assign(n, -1);
+	}
+}
+
+void ContractionHierarchy::save(string fileName) {
+	ofstream out(fileName, ios::binary);
+	if (!out.is_open()) throw FileNameErr(fileName);
+	out.write(magic, sizeof(magic));
+	out.write((const char*)&this->shortcutCount, sizeof(this->shortcutCount));
+	writeVector(out, this->ids);
+	writeVector(out, this->rank);
+	writeVector(out, this->upOffset);
+	writeVector(out, this->up);
+	writeVector(out, this->downOffset);
+	writeVector(out, this->down);
+	out.close();
+}
+
+int ContractionHierarchy::index(int v) {
+	auto it = lower_bound(this->ids.begin(), this->ids.end(), v);
+	if (it == this->ids.end() || *it != v) throw OperationErr("there is no such vertex");
+	return it - this->ids.begin();
+}
+
+long long ContractionHierarchy::search(int s, int t) {
+	for (int d = 0; d < 2; ++d) {
+		for (int v : this->touched[d]) {
+			this->dist[d][v] = unreachable;
+			this->parent[d][v] = -1;
+		}
+		this->touched[d].clear();
+	}
+	//       ;  ,      
+	vector<Item>* heap = this->heap;
+	const vector<int>* offset[2] = { &this->upOffset, &this->downOffset };
+	const vector<Arc>* arcs[2] = { &this->up, &this->down };
+	heap[0].assign(1, make_pair(0LL, s));
+	heap[1].assign(1, make_pair(0LL, t));
+	this->dist[0][s] = 0; this->touched[0].push_back(s);
+	this->dist[1][t] = 0; this->touched[1].push_back(t);
+	long long best = unreachable;
+	this->meet = -1;
+	while (!heap[0].empty() || !heap[1].empty()) {
+		int d = heap[1].empty() || (!heap[0].empty() && heap[0].front().first <= heap[1].front().first) ? 0 : 1;
+		pop_heap(heap[d].begin(), heap[d].end(), greater<Item>());
+		Item top = heap[d].back(); heap[d].pop_back();
+		int v = top.second;
+		if (top.first >= best) {
+			heap[d].clear();
+			continue;
+		}
+		if (top.first > this->dist[d][v]) continue;
+		GRAPH_STATS_ADD(visited, 1);
+		GRAPH_STATS_ADD(relaxed, (*offset[d])[v + 1] - (*offset[d])[v]);
+		if (this->dist[1 - d][v] < unreachable && top.first + this->dist[1 - d][v] < best) {
+			best = top.first + this->dist[1 - d][v];
+			this->meet = v;
+		}
+		for (int a = (*offset[d])[v]; a < (*offset[d])[v + 1]; ++a) {
+			const Arc& arc = (*arcs[d])[a];
+			long long du = top.first + arc.weight;
+			if (du < this->dist[d][arc.to]) {
+				if (this->dist[d][arc.to] == unreachable) this->touched[d].push_back(arc.to);
+				this->dist[d][arc.to] = du;
+				this->parent[d][arc.to] = v;
+				heap[d].push_back(make_pair(du, arc.to));
+				push_heap(heap[d].begin(), heap[d].end(), greater<Item>());
+			}
+		}
+	}
+	return best;
+}
+
+int ContractionHierarchy::distance(int u, int v) {
+	GRAPH_STATS_SCOPE("ContractionHierarchy::distance");
+	long long d = this->search(this->index(u), this->index(v));
+	if (d == unreachable) throw OperationErr("no way from u to v");
+	return (int)d;
+}
+
+int ContractionHierarchy::find(const vector<int>& offset, const vector<Arc>& arcs, int v, int to) {
+	for (int a = offset[v]; a < offset[v + 1]; ++a)
+		if (arcs[a].to == to) return a;
+	throw OperationErr("broken contraction hierarchy");
+}
+
+void ContractionHierarchy::unpack(int from, int to, int middle, vector<int>& path) {
+	if (middle < 0) {
+		path.push_back(to);
+		return;
+	}
+	//  from -> middle    middle  , middle -> to -  
+	this->unpack(from, middle, this->down[this->find(this->downOffset, this->down, middle, from)].middle, path);
+	this->unpack(middle, to, this->up[this->find(this->upOffset, this->up, middle, to)].middle, path);
+}
+
+vector<int> ContractionHierarchy::path(int u, int v) {
+	GRAPH_STATS_SCOPE("ContractionHierarchy::path");
+	if (this->search(this->index(u), this->index(v)) == unreachable)
+		throw OperationErr("no way from u to v");
+	vector<int> chain;
+	for (int x = this->meet; x >= 0; x = this->parent[0][x]) chain.push_back(x);
+	reverse(chain.begin(), chain.end());
+	vector<int> path(1, chain[0]);
+	for (size_t i = 1; i < chain.size(); ++i)
+		this->unpack(chain[i - 1], chain[i], this->up[this->find(this->upOffset, this->up, chain[i - 1], chain[i])].middle, path);
+	for (int x = this->meet; this->parent[1][x] >= 0; x = this->parent[1][x]) {
+		int y = this->parent[1][x];
+		this->unpack(x, y, this->down[this->find(this->downOffset, this->down, y, x)].middle, path);
+	}
+	for (auto& x : path) x = this->ids[x];
+	return path;
+}
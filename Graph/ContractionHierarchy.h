@@ -0,0 +1,48 @@
+#include <string>
+#include <vector>
+#include "Graph.h"
+
+using namespace std;
+
+#pragma once
+/*   (contraction hierarchy)      .
+        ( ,   , ),
+    .  -      .
+    ,         */
+class ContractionHierarchy
+{
+public:
+	ContractionHierarchy(Graph& g, Exec policy = Exec::sequential); //       
+	ContractionHierarchy(const string fileName); //  ,  save
+
+	void save(string fileName); //     
+	int distance(int u, int v); //     u  v
+	vector<int> path(int u, int v); //    u  v
+	int size() { return this->ids.size(); }
+	int shortcuts() { return this->shortcutCount; }
+
+private:
+	struct Arc
+	{
+		int to, weight, middle; // middle -   , -1   
+	};
+
+	long long search(int s, int t); //  dist/parent,       meet
+	void unpack(int from, int to, int middle, vector<int>& path); //     
+	int find(const vector<int>& offset, const vector<Arc>& arcs, int v, int to); //   v -> to
+	int index(int v);
+
+	vector<int> ids; //    
+	vector<int> rank; //  
+	// up -     , down -      
+	vector<int> upOffset, downOffset;
+	vector<Arc> up, down;
+	int shortcutCount;
+
+	//   ; touched -     
+	vector<long long> dist[2];
+	vector<int> parent[2];
+	vector<int> touched[2];
+	vector<pair<long long, int>> heap[2];
+	int meet;
+};
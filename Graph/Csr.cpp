@@ -0,0 +1,109 @@
+#include <algorithm>
+#include "Csr.h"
+#include "Stats.h"
+
+int Csr::index(int v) const {
+	auto it = lower_bound(this->ids.begin(), this->ids.end(), v);
+	if (it == this->ids.end() || *it != v) return -1;
+	return (int)(it - this->ids.begin());
+}
+
+Csr Csr::build(const vector<int>& ids, const vector<const vector<pair<int, int>>*>& rows, Exec policy) {
+	GRAPH_STATS_SCOPE("Csr::build");
+	Csr g;
+	g.ids = ids;
+	int n = g.size();
+
+	//      ,   ; ends[i]    from[i]
+	vector<int> from(n + 1, 0);
+	for (int i = 0; i < n; ++i) from[i + 1] = from[i] + (rows[i] ? (int)rows[i]->size() : 0);
+	vector<int> ends(from[n]);
+	g.offset.assign(n + 1, 0);
+	runFor(policy, 0, n, [&](int b, int e) {
+		for (int i = b; i < e; ++i) {
+			if (!rows[i]) continue;
+			int k = from[i];
+			for (auto& p : *rows[i]) ends[k++] = g.index(p.first);
+			g.offset[i + 1] = (int)count_if(ends.begin() + from[i], ends.begin() + k, [](int x) { return x >= 0; });
+		}
+	}, 256);
+	for (int i = 0; i < n; ++i) g.offset[i + 1] += g.offset[i];
+
+	g.target.resize(g.offset[n]);
+	g.weight.resize(g.offset[n]);
+	runFor(policy, 0, n, [&](int b, int e) {
+		for (int i = b; i < e; ++i) {
+			int pos = g.offset[i];
+			for (int j = from[i]; j < from[i + 1]; ++j) {
+				if (ends[j] < 0) continue;
+				g.target[pos] = ends[j];
+				g.weight[pos] = (*rows[i])[j - from[i]].second;
+				pos++;
+			}
+		}
+	}, 256);
+	g.negative = any_of(g.weight.begin(), g.weight.end(), [](int w) { return w < 0; });
+	GRAPH_STATS_ADD(visited, n);
+	GRAPH_STATS_ADD(relaxed, from[n]);
+	GRAPH_STATS_ADD(bytes, g.bytes());
+	return g;
+}
+
+Csr Csr::transposed(Exec policy) const {
+	GRAPH_STATS_SCOPE("Csr::transposed");
+	GRAPH_STATS_ADD(visited, this->size());
+	GRAPH_STATS_ADD(relaxed, this->arcs());
+	Csr t;
+	int n = this->size(), m = this->arcs();
+	t.ids = this->ids;
+	t.negative = this->negative;
+	t.offset.assign(n + 1, 0);
+	t.target.resize(m);
+	t.weight.resize(m);
+	t.arc.resize(m);
+	GRAPH_STATS_ADD(bytes, t.bytes());
+
+	if (policy == Exec::sequential) {
+		for (int a = 0; a < m; ++a) t.offset[this->target[a] + 1]++;
+		for (int i = 0; i < n; ++i) t.offset[i + 1] += t.offset[i];
+		vector<int> pos(t.offset.begin(), t.offset.end() - 1);
+		for (int i = 0; i < n; ++i)
+			for (int a = this->offset[i]; a < this->offset[i + 1]; ++a) {
+				int p = pos[this->target[a]]++;
+				t.target[p] = i;
+				t.weight[p] = this->weight[a];
+				t.arc[p] = a;
+			}
+		return t;
+	}
+
+	// :    ,    ,
+	//      
+	vector<atomic<int>> fill(n);
+	for (auto& f : fill) f = 0;
+	runFor(policy, 0, m, [&](int b, int e) {
+		for (int a = b; a < e; ++a) fill[this->target[a]]++;
+	}, 4096);
+	for (int i = 0; i < n; ++i) {
+		t.offset[i + 1] = t.offset[i] + fill[i];
+		fill[i] = t.offset[i];
+	}
+	runFor(policy, 0, m, [&](int b, int e) {
+		for (int a = b; a < e; ++a) t.arc[fill[this->target[a]]++] = a;
+	}, 4096);
+	vector<int> source(m);
+	runFor(policy, 0, n, [&](int b, int e) {
+		for (int i = b; i < e; ++i)
+			for (int a = this->offset[i]; a < this->offset[i + 1]; ++a) source[a] = i;
+	}, 256);
+	runFor(policy, 0, n, [&](int b, int e) {
+		for (int i = b; i < e; ++i) {
+			sort(t.arc.begin() + t.offset[i], t.arc.begin() + t.offset[i + 1]);
+			for (int p = t.offset[i]; p < t.offset[i + 1]; ++p) {
+				t.target[p] = source[t.arc[p]];
+				t.weight[p] = this->weight[t.arc[p]];
+			}
+		}
+	}, 256);
+	return t;
+}
@@ -0,0 +1,31 @@
+#include <utility>
+#include <vector>
+#include "Executor.h"
+
+using namespace std;
+
+#pragma once
+/*     (compressed sparse row):
+  0..n-1    ,
+  i   target/weight   [offset[i], offset[i+1]) */
+class Csr
+{
+public:
+	vector<int> ids; //    
+	vector<int> offset;
+	vector<int> target; //   
+	vector<int> weight;
+	vector<int> arc; //   :   
+	bool negative = false; //     
+
+	int size() const { return (int)this->ids.size(); }
+	int arcs() const { return (int)this->target.size(); }
+	int degree(int i) const { return this->offset[i + 1] - this->offset[i]; }
+	int index(int v) const; //    , -1   
+	size_t bytes() const { return (this->ids.size() + this->offset.size() + this->target.size() + this->weight.size() + this->arc.size()) * sizeof(int); }
+
+	//     ids ( ); nullptr -  ,     
+	static Csr build(const vector<int>& ids, const vector<const vector<pair<int, int>>*>& rows, Exec policy = Exec::sequential);
+	//  ;        
+	Csr transposed(Exec policy = Exec::sequential) const;
+};
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include "Executor.h"
+#include "Stats.h"
+
+namespace {
+	thread_local ThreadPool* currentPool = nullptr;
+	thread_local int currentWorker = -1;
+
+	mutex poolM;
+	unique_ptr<ThreadPool> sharedPool;
+	int requestedThreads = 0; // ,  setDefaultThreads   
+
+	int defaultThreads() {
+		string env;
+#ifdef _MSC_VER
+		char* buf = nullptr; size_t len = 0;
+		if (_dupenv_s(&buf, &len, "GRAPH_THREADS") == 0 && buf) {
+			env = buf;
+			free(buf);
+		}
+#else
+		if (const char* buf = getenv("GRAPH_THREADS")) env = buf;
+#endif
+		int n = 0;
+		try {
+			if (!env.empty()) n = stoi(env);
+		}
+		catch (...) {
+			n = 0;
+		}
+		if (n <= 0) n = (int)thread::hardware_concurrency();
+		return max(n, 1);
+	}
+}
+
+ThreadPool::ThreadPool(int threads) : pending(0), nextQueue(0), stop(false) {
+	threads = max(threads, 1);
+	for (int i = 0; i < threads; ++i)
+		this->queues.push_back(unique_ptr<Queue>(new Queue()));
+	for (int i = 0; i < threads; ++i)
+		this->workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		lock_guard<mutex> lk(this->sleepM);
+		this->stop = true;
+	}
+	this->wake.notify_all();
+	for (auto& t : this->workers) t.join();
+}
+
+void ThreadPool::submit(function<void()> task) {
+	int q = (currentPool == this) ? currentWorker : (int)(this->nextQueue++ % this->queues.size());
+	{
+		lock_guard<mutex> lk(this->queues[q]->m);
+		this->queues[q]->tasks.push_back(move(task));
+	}
+	{
+		lock_guard<mutex> lk(this->sleepM);
+		this->pending++;
+	}
+	this->wake.notify_one();
+}
+
+bool ThreadPool::tryRunOne(int self) {
+	function<void()> task;
+	int n = this->queues.size();
+	//   -  ,  -  
+	if (self >= 0) {
+		lock_guard<mutex> lk(this->queues[self]->m);
+		if (!this->queues[self]->tasks.empty()) {
+			task = move(this->queues[self]->tasks.back());
+			this->queues[self]->tasks.pop_back();
+		}
+	}
+	for (int i = 1; !task && i <= n; ++i) {
+		int q = ((self >= 0 ? self : 0) + i) % n;
+		lock_guard<mutex> lk(this->queues[q]->m);
+		if (!this->queues[q]->tasks.empty()) {
+			task = move(this->queues[q]->tasks.front());
+			this->queues[q]->tasks.pop_front();
+		}
+	}
+	if (!task) return false;
+	this->pending--;
+	task();
+	return true;
+}
+
+void ThreadPool::workerLoop(int id) {
+	currentPool = this;
+	currentWorker = id;
+	while (true) {
+		if (this->tryRunOne(id)) continue;
+		unique_lock<mutex> lk(this->sleepM);
+		this->wake.wait(lk, [this] { return this->stop || this->pending > 0; });
+		if (this->stop && this->pending == 0) return;
+	}
+}
+
+void ThreadPool::parallelFor(int begin, int end, const function<void(int, int)>& body, int grain) {
+	if (end <= begin) return;
+	grain = max(grain, 1);
+	int n = end - begin;
+	int chunks = min((n + grain - 1) / grain, this->size() * 4);
+	if (chunks <= 1 || this->size() == 1) {
+		body(begin, end);
+		return;
+	}
+	int step = (n + chunks - 1) / chunks;
+	chunks = (n + step - 1) / step;
+
+	atomic<int> left(chunks);
+	vector<exception_ptr> errors(chunks);
+#ifdef GRAPH_STATS
+	//     ,  
+	GraphStats::Method* caller = GraphStats::current();
+#endif
+	for (int c = 0; c < chunks; ++c) {
+		int b = begin + c * step, e = min(end, b + step);
+		this->submit([&, c, b, e]() {
+#ifdef GRAPH_STATS
+			GraphStats::Bind bind(caller);
+#endif
+			try {
+				body(b, e);
+			}
+			catch (...) {
+				errors[c] = current_exception();
+			}
+			left--;
+		});
+	}
+	//     ,      
+	int self = (currentPool == this) ? currentWorker : -1;
+	while (left > 0)
+		if (!this->tryRunOne(self)) this_thread::yield();
+	//    ,      
+	for (auto& e : errors)
+		if (e) rethrow_exception(e);
+}
+
+ThreadPool& ThreadPool::instance() {
+	lock_guard<mutex> lk(poolM);
+	if (!sharedPool) sharedPool.reset(new ThreadPool(requestedThreads > 0 ? requestedThreads : defaultThreads()));
+	return *sharedPool;
+}
+
+void ThreadPool::setDefaultThreads(int n) {
+	lock_guard<mutex> lk(poolM);
+	int threads = n > 0 ? n : defaultThreads();
+	//    :        
+	if (sharedPool) {
+		if (sharedPool->size() != threads) throw logic_error("thread pool is already in use");
+		return;
+	}
+	requestedThreads = threads;
+}
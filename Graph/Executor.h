@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#pragma once
+//     
+enum class Exec { sequential, parallel };
+
+/*       (work stealing):
+    ,       .
+   - hardware_concurrency,  
+ GRAPH_THREADS   setDefaultThreads */
+class ThreadPool
+{
+public:
+	explicit ThreadPool(int threads);
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	int size() const { return (int)this->workers.size(); }
+	void submit(function<void()> task); //    
+	//  [begin, end)     body(b, e)  ,  
+	void parallelFor(int begin, int end, const function<void(int, int)>& body, int grain = 1);
+
+	static ThreadPool& instance(); //   
+	//    ;   instance()   - logic_error
+	static void setDefaultThreads(int n);
+
+private:
+	struct Queue
+	{
+		mutex m;
+		deque<function<void()>> tasks;
+	};
+
+	bool tryRunOne(int self); //        
+	void workerLoop(int id);
+
+	vector<unique_ptr<Queue>> queues;
+	vector<thread> workers;
+	atomic<int> pending;
+	atomic<unsigned> nextQueue;
+	mutex sleepM;
+	condition_variable wake;
+	bool stop;
+};
+
+//  body(b, e)   [begin, end):     .
+//  body  ,    function   
+template<class Body>
+void runFor(Exec policy, int begin, int end, const Body& body, int grain = 1) {
+	if (policy == Exec::sequential) {
+		if (begin < end) body(begin, end);
+		return;
+	}
+	ThreadPool::instance().parallelFor(begin, end, body, grain);
+}
+
+//  ;       ,   
+template <class T, class Less>
+void stableSort(Exec policy, vector<T>& a, Less less) {
+	int n = (int)a.size();
+	if (policy == Exec::sequential || n < 4096) {
+		stable_sort(a.begin(), a.end(), less);
+		return;
+	}
+	ThreadPool& pool = ThreadPool::instance();
+	int parts = pool.size();
+	vector<int> bound(parts + 1);
+	for (int p = 0; p <= parts; ++p) bound[p] = (int)((long long)n * p / parts);
+	pool.parallelFor(0, parts, [&](int b, int e) {
+		for (int p = b; p < e; ++p)
+			stable_sort(a.begin() + bound[p], a.begin() + bound[p + 1], less);
+	});
+	vector<T> buf(a);
+	for (int w = 1; w < parts; w *= 2) {
+		pool.parallelFor(0, (parts + 2 * w - 1) / (2 * w), [&](int b, int e) {
+			for (int q = b; q < e; ++q) {
+				int lo = q * 2 * w, mid = min(lo + w, parts), hi = min(lo + 2 * w, parts);
+				merge(a.begin() + bound[lo], a.begin() + bound[mid], a.begin() + bound[mid], a.begin() + bound[hi],
+					buf.begin() + bound[lo], less);
+			}
+		});
+		a.swap(buf);
+	}
+}
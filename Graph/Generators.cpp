@@ -0,0 +1,253 @@
+#include <algorithm>
+#include "Generators.h"
+#include "Writer.h"
+
+namespace {
+	typedef GraphGenerator::Arc Arc;
+	typedef GraphGenerator::Random Random;
+
+	//     
+	const long long blockEdges = 1 << 16;
+	//       
+	const int batchBlocks = 64;
+
+	unsigned long long mix(unsigned long long x) {
+		x += 0x9e3779b97f4a7c15ULL;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		return x ^ (x >> 31);
+	}
+
+	/*   e  -    ( -):
+	    , 2e -   e, 2e + 1 -  .   - 
+	 ,      ;     */
+	int attachTarget(long long e, int m, unsigned long long seed) {
+		int source = (int)(e / m) + 1;
+		if (e == 0) return 0;
+		for (int attempt = 0; attempt < 8; ++attempt) {
+			long long p = (long long)(mix(seed ^ mix((unsigned long long)e * 8 + attempt)) % (unsigned long long)(2 * e));
+			int t = p % 2 == 0 ? (int)(p / 2 / m) + 1 : attachTarget(p / 2, m, seed);
+			if (t != source) return t;
+		}
+		//     -    
+		return (int)(mix(seed ^ mix((unsigned long long)e * 8 + 7)) % source);
+	}
+}
+
+unsigned long long GraphGenerator::Random::next() {
+	this->state += 0x9e3779b97f4a7c15ULL;
+	unsigned long long x = this->state;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+long long GraphGenerator::Random::below(long long r) {
+	return (long long)(this->next() % (unsigned long long)r);
+}
+
+double GraphGenerator::Random::real() {
+	return (this->next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+GraphGenerator::GraphGenerator(int n, long long edges, long long blocks, bool directed, unsigned long long seed, Block block)
+	: n(n), edges(edges), blocks(blocks), isDirected(directed), isWeighted(true), lo(1), hi(100), seed(seed), block(block) {}
+
+GraphGenerator GraphGenerator::erdosRenyi(int n, long long m, unsigned long long seed) {
+	if (n < 2 || m < 0) throw OperationErr("need at least 2 vertexs and non-negative amount of edges");
+	long long blocks = (m + blockEdges - 1) / blockEdges;
+	return GraphGenerator(n, m, blocks, false, seed, [n, m](long long b, Random& rnd, vector<Arc>& out) {
+		long long count = min(blockEdges, m - b * blockEdges);
+		for (long long i = 0; i < count; ++i) {
+			int u = (int)rnd.below(n), v = (int)rnd.below(n - 1);
+			if (v >= u) v++;
+			out.push_back({ u + 1, v + 1, 0 });
+		}
+	});
+}
+
+GraphGenerator GraphGenerator::rmat(int scale, int edgeFactor, unsigned long long seed, double a, double b, double c) {
+	if (scale < 1 || scale > 30 || edgeFactor < 0 || a < 0 || b < 0 || c < 0 || a + b + c > 1)
+		throw OperationErr("incorrect R-MAT parameters");
+	int n = 1 << scale;
+	long long m = (long long)edgeFactor * n;
+	long long blocks = (m + blockEdges - 1) / blockEdges;
+	unsigned mask = (unsigned)n - 1;
+	//  :     xorshift    2^scale
+	unsigned mul = (unsigned)(mix(seed) | 1);
+	auto scramble = [=](unsigned x) {
+		x = (x * mul) & mask;
+		x ^= x >> (scale / 2 + 1);
+		return (int)((x * mul) & mask) + 1;
+	};
+	return GraphGenerator(n, m, blocks, false, seed, [=](long long blk, Random& rnd, vector<Arc>& out) {
+		long long count = min(blockEdges, m - blk * blockEdges);
+		for (long long i = 0; i < count; ++i) {
+			unsigned u, v;
+			do {
+				u = v = 0;
+				for (int bit = scale - 1; bit >= 0; --bit) {
+					double r = rnd.real();
+					if (r >= a + b + c) { u |= 1u << bit; v |= 1u << bit; }
+					else if (r >= a + b) u |= 1u << bit;
+					else if (r >= a) v |= 1u << bit;
+				}
+			} while (u == v);
+			out.push_back({ scramble(u), scramble(v), 0 });
+		}
+	});
+}
+
+GraphGenerator GraphGenerator::barabasiAlbert(int n, int m, unsigned long long seed) {
+	if (n < 2 || m < 1) throw OperationErr("need at least 2 vertexs and 1 edge per vertex");
+	long long total = (long long)(n - 1) * m;
+	long long blocks = (total + blockEdges - 1) / blockEdges;
+	return GraphGenerator(n, total, blocks, false, seed, [=](long long b, Random&, vector<Arc>& out) {
+		long long end = min(total, (b + 1) * blockEdges);
+		for (long long e = b * blockEdges; e < end; ++e)
+			out.push_back({ (int)(e / m) + 2, attachTarget(e, m, seed) + 1, 0 });
+	});
+}
+
+GraphGenerator GraphGenerator::grid(int rows, int cols, unsigned long long seed, double dropout) {
+	if (rows < 1 || cols < 1 || (long long)rows * cols > 2000000000LL || dropout < 0 || dropout >= 1)
+		throw OperationErr("incorrect grid parameters");
+	int perBlock = (int)max(1LL, blockEdges / (2LL * cols));
+	long long blocks = (rows + perBlock - 1) / perBlock;
+	long long m = (long long)rows * (cols - 1) + (long long)(rows - 1) * cols;
+	return GraphGenerator(rows * cols, m, blocks, false, seed, [=](long long b, Random& rnd, vector<Arc>& out) {
+		int last = (int)min<long long>(rows, (b + 1) * perBlock);
+		for (int r = (int)b * perBlock; r < last; ++r)
+			for (int c = 0; c < cols; ++c) {
+				int v = r * cols + c + 1;
+				if (c + 1 < cols && rnd.real() >= dropout) out.push_back({ v, v + 1, 0 });
+				if (r + 1 < rows && rnd.real() >= dropout) out.push_back({ v, v + cols, 0 });
+			}
+	});
+}
+
+GraphGenerator GraphGenerator::layeredFlow(int layers, int width, int degree, unsigned long long seed) {
+	if (layers < 1 || width < 1 || degree < 1 || (long long)layers * width > 2000000000LL)
+		throw OperationErr("incorrect flow network parameters");
+	int n = layers * width + 2;
+	int perBlock = (int)max(1LL, blockEdges / degree);
+	long long parts = (width + perBlock - 1) / perBlock;
+	long long m = (long long)(layers - 1) * width * degree + 2LL * width;
+	GraphGenerator g(n, m, layers * parts, true, seed, [=](long long b, Random& rnd, vector<Arc>& out) {
+		int layer = (int)(b / parts);
+		int first = (int)(b % parts) * perBlock, last = min(width, first + perBlock);
+		for (int j = first; j < last; ++j) {
+			int v = 2 + layer * width + j;
+			if (layer == 0) out.push_back({ 1, v, 0 });
+			if (layer + 1 < layers)
+				for (int k = 0; k < degree; ++k)
+					out.push_back({ v, 2 + (layer + 1) * width + (int)rnd.below(width), 0 });
+			else out.push_back({ v, n, 0 });
+		}
+	});
+	return g;
+}
+
+GraphGenerator& GraphGenerator::directed(bool d) {
+	this->isDirected = d;
+	return *this;
+}
+
+GraphGenerator& GraphGenerator::weights(int lo, int hi) {
+	if (lo > hi) throw OperationErr("incorrect weight range");
+	this->isWeighted = true;
+	this->lo = lo;
+	this->hi = hi;
+	return *this;
+}
+
+GraphGenerator& GraphGenerator::unweighted() {
+	this->isWeighted = false;
+	return *this;
+}
+
+void GraphGenerator::generate(long long b, vector<Arc>& out) const {
+	Random rnd = { mix(this->seed ^ mix((unsigned long long)b + 1)) };
+	size_t from = out.size();
+	this->block(b, rnd, out);
+	//        
+	for (size_t i = from; i < out.size(); ++i)
+		out[i].weight = this->isWeighted ? this->lo + (int)rnd.below((long long)this->hi - this->lo + 1) : 0;
+}
+
+void GraphGenerator::collect(int lo, int hi, Exec policy, vector<Arc>& arcs, vector<long long>& first) const {
+	//     ;      ,  
+	vector<Arc> raw;
+	vector<vector<Arc>> part(batchBlocks);
+	for (long long b0 = 0; b0 < this->blocks; b0 += batchBlocks) {
+		int count = (int)min<long long>(batchBlocks, this->blocks - b0);
+		runFor(policy, 0, count, [&](int b, int e) {
+			vector<Arc> out;
+			for (int i = b; i < e; ++i) {
+				out.clear();
+				this->generate(b0 + i, out);
+				part[i].clear();
+				for (auto& a : out) {
+					if (a.from >= lo && a.from < hi) part[i].push_back(a);
+					if (!this->isDirected && a.to != a.from && a.to >= lo && a.to < hi)
+						part[i].push_back({ a.to, a.from, a.weight });
+				}
+			}
+		});
+		for (int i = 0; i < count; ++i) raw.insert(raw.end(), part[i].begin(), part[i].end());
+	}
+
+	//      
+	first.assign(hi - lo + 1, 0);
+	for (auto& a : raw) first[a.from - lo + 1]++;
+	for (int i = 0; i < hi - lo; ++i) first[i + 1] += first[i];
+	vector<long long> pos(first.begin(), first.end() - 1);
+	arcs.resize(raw.size());
+	for (auto& a : raw) arcs[pos[a.from - lo]++] = a;
+}
+
+Graph GraphGenerator::build(Exec policy) const {
+	vector<Arc> arcs;
+	vector<long long> first;
+	this->collect(1, this->n + 1, policy, arcs, first);
+	map<int, vector<pair<int, int>>> adj;
+	for (int v = 1; v <= this->n; ++v) {
+		vector<pair<int, int>> row;
+		row.reserve(first[v] - first[v - 1]);
+		for (long long i = first[v - 1]; i < first[v]; ++i) row.push_back(make_pair(arcs[i].to, arcs[i].weight));
+		adj.emplace_hint(adj.end(), v, move(row));
+	}
+	return Graph(this->isDirected, this->isWeighted, move(adj));
+}
+
+void GraphGenerator::write(const string& fileName, Exec policy, long long memoryArcs) const {
+	ofstream out(fileName);
+	if (!out.is_open()) throw FileNameErr(fileName);
+	out << (this->isDirected ? "directed" : "undirected") << "\n" << (this->isWeighted ? "weighted" : "unweighted") << "\n";
+
+	long long total = this->edges * (this->isDirected ? 1 : 2);
+	long long passes = max(1LL, (total + max(1LL, memoryArcs) - 1) / max(1LL, memoryArcs));
+	int chunk = (int)((this->n + passes - 1) / passes);
+	vector<Arc> arcs;
+	vector<long long> first;
+	for (int lo = 1; lo <= this->n; lo += chunk) {
+		int hi = (int)min<long long>(this->n + 1, (long long)lo + chunk);
+		this->collect(lo, hi, policy, arcs, first);
+		writeRows(out, hi - lo, [&](size_t i, string& s) {
+			appendInt(s, lo + (int)i);
+			s += ':';
+			for (long long k = first[i]; k < first[i + 1]; ++k) {
+				s += ' ';
+				appendInt(s, arcs[k].to);
+				if (this->isWeighted) {
+					s += " (";
+					appendInt(s, arcs[k].weight);
+					s += ')';
+				}
+				s += ';';
+			}
+			s += '\n';
+		}, policy);
+	}
+	if (!out) throw FileNameErr(fileName);
+}
@@ -0,0 +1,67 @@
+#include <functional>
+#include <string>
+#include <vector>
+#include "Executor.h"
+#include "Graph.h"
+
+using namespace std;
+
+#pragma once
+/*      .     ,
+    ,   ,        seed,
+      .   1..n */
+class GraphGenerator
+{
+public:
+	// G(n, m): m      ,   
+	static GraphGenerator erdosRenyi(int n, long long m, unsigned long long seed = 1);
+	// R-MAT: 2^scale , edgeFactor * 2^scale ,   a, b, c (d = 1 - a - b - c);
+	//   ,      
+	static GraphGenerator rmat(int scale, int edgeFactor, unsigned long long seed = 1, double a = 0.57, double b = 0.19, double c = 0.19);
+	// -:      m   ,  
+	static GraphGenerator barabasiAlbert(int n, int m, unsigned long long seed = 1);
+	//  rows x cols     ; dropout -   ,    
+	static GraphGenerator grid(int rows, int cols, unsigned long long seed = 1, double dropout = 0);
+	//    :  1, layers   width ,   degree    ,  n
+	static GraphGenerator layeredFlow(int layers, int width, int degree, unsigned long long seed = 1);
+
+	GraphGenerator& directed(bool d); //     layeredFlow
+	GraphGenerator& weights(int lo, int hi); //  ( )   [lo, hi],   1..100
+	GraphGenerator& unweighted();
+
+	int vertexCount() const { return this->n; }
+	long long edgeCount() const { return this->edges; } //    
+	Graph build(Exec policy = Exec::sequential) const; //   
+	/*      Graph.    memoryArcs,     :
+	             */
+	void write(const string& fileName, Exec policy = Exec::sequential, long long memoryArcs = 1LL << 26) const;
+
+	//     (splitmix64):     
+	struct Random
+	{
+		unsigned long long state;
+		unsigned long long next();
+		long long below(long long r); //   [0, r)
+		double real(); //   [0, 1)
+	};
+
+	struct Arc
+	{
+		int from, to, weight;
+	};
+
+private:
+	typedef function<void(long long block, Random& rnd, vector<Arc>& out)> Block;
+
+	GraphGenerator(int n, long long edges, long long blocks, bool directed, unsigned long long seed, Block block);
+	void generate(long long block, vector<Arc>& out) const; //    
+	//     [lo, hi),   ;   lo + i   [first[i], first[i + 1])
+	void collect(int lo, int hi, Exec policy, vector<Arc>& arcs, vector<long long>& first) const;
+
+	int n;
+	long long edges, blocks;
+	bool isDirected, isWeighted;
+	int lo, hi;
+	unsigned long long seed;
+	Block block;
+};
@@ -1,91 +1,272 @@
 #include <algorithm>
+#include <queue>
 #include <stack>
+#include <tuple>
 #include "Graph.h"
+#include "Bfs.h"
+#include "Csr.h"
+#include "Arena.h"
+#include "Writer.h"
+
+void parseAdjLine(string s, bool weighted, int& firstV, vector<pair<int, int>>& adj) {
+	int secondV, weight = 0;
+	size_t pos = s.find(": ");
+	firstV = stoi(s.substr(0, pos));
+	s.erase(0, pos + 2);
+
+	if (weighted) {
+		pos = s.find(" ");
+		while (pos != std::string::npos) {
+			secondV = stoi(s.substr(0, pos));
+			s.erase(0, pos + 1);
+			pos = s.find(")");
+			weight = stoi(s.substr(1, pos));
+			adj.push_back(make_pair(secondV, weight));
+			s.erase(0, pos + 3);
+			pos = s.find(" ");
+		}
+	}
+	else {
+		pos = s.find(";");
+		while (pos != std::string::npos) {
+			secondV = stoi(s.substr(0, pos));
+			s.erase(0, pos + 2);
+			adj.push_back(make_pair(secondV, weight));
+			pos = s.find(";");
+		}
+	}
+}
+
+/*       :    ,
+       */
+static AdjacencyMap buildAdjacency(vector<pair<int, vector<pair<int, int>>>> rows) {
+	stable_sort(rows.begin(), rows.end(), [](const pair<int, vector<pair<int, int>>>& a, const pair<int, vector<pair<int, int>>>& b) {
+		return a.first < b.first;
+	});
+	size_t k = 0;
+	for (size_t i = 0; i < rows.size(); ++i) {
+		if (i + 1 < rows.size() && rows[i + 1].first == rows[i].first) continue;
+		if (k != i) rows[k] = move(rows[i]);
+		k++;
+	}
+	rows.resize(k);
+	return AdjacencyMap::build(move(rows));
+}
+
+void Graph::readAdjList(istream& in, Exec policy) {
+	GRAPH_STATS_SCOPE("readAdjList");
+	string s;
+	vector<pair<int, vector<pair<int, int>>>> rows;
+	if (policy == Exec::sequential) {
+		while (getline(in, s)) {
+			rows.emplace_back();
+			parseAdjLine(s, this->state->weighted, rows.back().first, rows.back().second);
+			GRAPH_STATS_ADD(visited, 1);
+			GRAPH_STATS_ADD(relaxed, rows.back().second.size());
+		}
+		this->state->adjList = buildAdjacency(move(rows));
+		return;
+	}
+
+	//   ,        
+	vector<string> lines;
+	while (getline(in, s)) lines.push_back(move(s));
+	rows.resize(lines.size());
+	runFor(policy, 0, lines.size(), [&](int b, int e) {
+		for (int i = b; i < e; ++i) {
+			parseAdjLine(lines[i], this->state->weighted, rows[i].first, rows[i].second);
+			GRAPH_STATS_ADD(relaxed, rows[i].second.size());
+		}
+	}, 256);
+	GRAPH_STATS_ADD(visited, lines.size());
+	this->state->adjList = buildAdjacency(move(rows));
+}
 
 map<int, vector<pair<int, int>>> Graph::getAdjList() {
-	return this->adjList;
+	map<int, vector<pair<int, int>>> adj;
+	for (auto it = this->state->adjList.begin(); it != this->state->adjList.end(); ++it) adj.emplace_hint(adj.end(), it->first, it->second);
+	return adj;
+}
+
+vector<int> Graph::vertexNames() const {
+	vector<int> names;
+	names.reserve(this->state->adjList.size());
+	for (auto it = this->state->adjList.begin(); it != this->state->adjList.end(); ++it) names.push_back(it->first);
+	return names;
 }
 
-vector<Edge> Graph::getEdgeList() {
-	vector<Edge> edgesList;
-	bool isWeighted = this->weighted;
-	for (auto it = this->adjList.begin(); it != this->adjList.end(); ++it) {
-		int f = it->first; vector<pair<int, int>> pairs = it->second;
-		for (int i = 0; i < pairs.size(); i++) {
-			edgesList.push_back(Edge(f, pairs[i].first, pairs[i].second, isWeighted));
+/*     :  ,
+        ,    .
+  ,       part  parts */
+static void markReverseEdges(const vector<Edge>& edges, vector<char>& keep, int part, int parts) {
+	map<tuple<int, int, int>, int> waiting;
+	for (size_t i = 0; i < edges.size(); ++i) {
+		const Edge& e = edges[i];
+		unsigned long long h = (unsigned long long)(unsigned)min(e.first, e.second) * 1000003ULL
+			^ (unsigned long long)(unsigned)max(e.first, e.second) * 998244353ULL ^ (unsigned)e.weight;
+		if (h % parts != (unsigned long long)part) continue;
+		auto it = waiting.find(make_tuple(e.first, e.second, e.weight));
+		if (it != waiting.end() && it->second > 0) {
+			it->second--;
+			keep[i] = 0;
 		}
+		else waiting[make_tuple(e.second, e.first, e.weight)]++;
 	}
-	//      
-	if (!this->directed) {
-		auto it_edge1 = edgesList.begin();
-		while (it_edge1 != edgesList.end()) {
-			auto it_edge2 = it_edge1 + 1;
-			while (it_edge2 != edgesList.end()) {
-				if (it_edge1->isReverse(*it_edge2)) {
-					edgesList.erase(it_edge2);
-					break;
-				}
-				it_edge2++;
-			}
-			it_edge1++;
+}
+
+vector<Edge> Graph::getEdgeList(Exec policy) {
+	GRAPH_STATS_SCOPE("getEdgeList");
+	bool isWeighted = this->state->weighted;
+	vector<const vector<pair<int, int>>*> rows;
+	vector<int> firsts, start(1, 0);
+	for (auto it = this->state->adjList.begin(); it != this->state->adjList.end(); ++it) {
+		rows.push_back(&it->second);
+		firsts.push_back(it->first);
+		start.push_back(start.back() + it->second.size());
+	}
+	vector<Edge> edgesList(start.back(), Edge(0, 0, isWeighted));
+	GRAPH_STATS_ADD(visited, rows.size());
+	GRAPH_STATS_ADD(relaxed, edgesList.size());
+	runFor(policy, 0, rows.size(), [&](int b, int e) {
+		for (int i = b; i < e; ++i) {
+			const vector<pair<int, int>>& pairs = *rows[i];
+			for (size_t j = 0; j < pairs.size(); j++)
+				edgesList[start[i] + j] = Edge(firsts[i], pairs[j].first, pairs[j].second, isWeighted);
 		}
+	}, 256);
+	//      
+	if (!this->state->directed) {
+		vector<char> keep(edgesList.size(), 1);
+		int parts = policy == Exec::sequential ? 1 : ThreadPool::instance().size();
+		runFor(policy, 0, parts, [&](int b, int e) {
+			for (int part = b; part < e; ++part)
+				markReverseEdges(edgesList, keep, part, parts);
+		});
+		int k = 0;
+		for (size_t i = 0; i < edgesList.size(); ++i)
+			if (keep[i]) edgesList[k++] = edgesList[i];
+		edgesList.erase(edgesList.begin() + k, edgesList.end());
 	}
 	return edgesList;
 }
 
 bool Graph::isDirected() {
-	return this->directed;
+	return this->state->directed;
 }
 
 bool Graph::isWeighted() {
-	return this->weighted;
+	return this->state->weighted;
+}
+
+shared_ptr<const Csr> Graph::getCsr(Exec policy) {
+	shared_ptr<const Csr> g = atomic_load(&this->state->csr);
+	if (!g) {
+		vector<int> ids;
+		vector<const vector<pair<int, int>>*> rows;
+		for (auto it = this->state->adjList.begin(); it != this->state->adjList.end(); ++it) {
+			ids.push_back(it->first);
+			rows.push_back(&it->second);
+		}
+		g = make_shared<const Csr>(Csr::build(ids, rows, policy));
+		atomic_store(&this->state->csr, g);
+	}
+	return g;
+}
+
+shared_ptr<const Csr> Graph::getInvCsr(Exec policy) {
+	//      
+	if (!this->state->directed) return this->getCsr(policy);
+	shared_ptr<const Csr> g = atomic_load(&this->state->invCsr);
+	if (!g) {
+		g = make_shared<const Csr>(this->getCsr(policy)->transposed(policy));
+		atomic_store(&this->state->invCsr, g);
+	}
+	return g;
+}
+
+void Graph::publish(const AdjacencyMap& adj) {
+	shared_ptr<State> next = make_shared<State>();
+	next->directed = this->state->directed;
+	next->weighted = this->state->weighted;
+	next->adjList = adj;
+	atomic_store(&this->state, next);
+}
+
+shared_ptr<AvoidIndex> Graph::getAvoidIndex() {
+	shared_ptr<AvoidIndex> idx = atomic_load(&this->state->avoidIndex);
+	if (!idx) {
+		idx = make_shared<AvoidIndex>(this->getCsr(), this->getInvCsr(), this->state->directed);
+		atomic_store(&this->state->avoidIndex, idx);
+	}
+	return idx;
+}
+
+//    ,    
+static void addArc(AdjacencyMap& adj, int f, pair<int, int> arc) {
+	vector<pair<int, int>> row = adj.find(f)->second;
+	row.push_back(arc);
+	adj.set(f, move(row));
+}
+
+static void eraseArc(AdjacencyMap& adj, int f, pair<int, int> arc) {
+	vector<pair<int, int>> row = adj.find(f)->second;
+	row.erase(find(row.begin(), row.end(), arc));
+	adj.set(f, move(row));
 }
 
 void Graph::addEdge(int f, int s, int w) {
-	if (this->vertexs.find(f) == this->vertexs.end() || this->vertexs.find(s) == this->vertexs.end())
+	GRAPH_STATS_SCOPE("addEdge");
+	if (!this->state->adjList.count(f) || !this->state->adjList.count(s))
 		throw OperationErr("there is no such vertex(s)");
 
 	vector<Edge> edges = this->getEdgeList();
-	if (find(edges.begin(), edges.end(), Edge(f, s, w, this->weighted)) != edges.end())
+	if (find(edges.begin(), edges.end(), Edge(f, s, w, this->state->weighted)) != edges.end())
 		throw OperationErr("such edge already exists");
 
-	this->adjList[f].push_back(make_pair(s, w));
-	if (!this->directed)
-		this->adjList[s].push_back(make_pair(f, w));
+	//       ,      
+	AdjacencyMap adj = this->state->adjList;
+	addArc(adj, f, make_pair(s, w));
+	if (!this->state->directed)
+		addArc(adj, s, make_pair(f, w));
+	this->publish(adj);
 }
 
 void Graph::addVertex(int v) {
-	if (this->vertexs.find(v) != this->vertexs.end())
+	GRAPH_STATS_SCOPE("addVertex");
+	if (this->state->adjList.count(v))
 		throw OperationErr("vertex with such name already exists");
 
-	this->vertexs.insert(v);
-	this->adjList[v] = {};
+	AdjacencyMap adj = this->state->adjList;
+	adj.set(v, {});
+	this->publish(adj);
 }
 
 void Graph::deleteVertex(int v) {
-	if (this->vertexs.find(v) == this->vertexs.end())
+	GRAPH_STATS_SCOPE("deleteVertex");
+	if (!this->state->adjList.count(v))
 		throw OperationErr("there is no such vertex");
 
-	this->vertexs.erase(v);
-	this->adjList.erase(v);
-	for (auto adj_it = this->adjList.begin(); adj_it != this->adjList.end(); ++adj_it) {
-		auto pair_it = adj_it->second.begin();
-		while (pair_it != adj_it->second.end()) {
-			if (pair_it->first == v) {
-				(adj_it->second).erase(pair_it);
-				pair_it = adj_it->second.begin();
-				continue;
-			}
-			pair_it++;
-		}
+	//        v,     
+	AdjacencyMap adj = this->state->adjList;
+	adj.erase(v);
+	for (auto adj_it = this->state->adjList.begin(); adj_it != this->state->adjList.end(); ++adj_it) {
+		const vector<pair<int, int>>& row = adj_it->second;
+		if (adj_it->first == v || none_of(row.begin(), row.end(), [&](const pair<int, int>& p) { return p.first == v; }))
+			continue;
+		vector<pair<int, int>> kept;
+		for (auto& p : row)
+			if (p.first != v) kept.push_back(p);
+		adj.set(adj_it->first, move(kept));
 	}
+	this->publish(adj);
 }
 
 void Graph::deleteEdge(int f, int s) {
-	if (this->vertexs.find(f) == this->vertexs.end() || this->vertexs.find(s) == this->vertexs.end())
+	GRAPH_STATS_SCOPE("deleteEdge");
+	if (!this->state->adjList.count(f) || !this->state->adjList.count(s))
 		throw OperationErr("there is no such vertex(s)");
 
-	if (this->weighted)
+	if (this->state->weighted)
 		throw OperationErr("specify weight of the edge");
 
 	vector<Edge> edges = this->getEdgeList();
@@ -93,61 +274,59 @@ void Graph::deleteEdge(int f, int s) {
 	if (find(edges.begin(), edges.end(), Edge(f, s, false)) == edges.end())
 		throw OperationErr("there is no such edge");
 
-	auto it = find(this->adjList[f].begin(), this->adjList[f].end(), make_pair(s, 0));
-	this->adjList[f].erase(it);
-	if (!this->directed) {
-		it = find(this->adjList[s].begin(), this->adjList[s].end(), make_pair(f, 0));
-		this->adjList[s].erase(it);
-	}
+	AdjacencyMap adj = this->state->adjList;
+	eraseArc(adj, f, make_pair(s, 0));
+	if (!this->state->directed)
+		eraseArc(adj, s, make_pair(f, 0));
+	this->publish(adj);
 }
 
 void Graph::deleteEdge(int f, int s, int w) {
-	if (!this->weighted)
+	GRAPH_STATS_SCOPE("deleteEdge");
+	if (!this->state->weighted)
 		throw OperationErr("graph is unweighted");
 
-	if (this->vertexs.find(f) == this->vertexs.end() || this->vertexs.find(s) == this->vertexs.end())
+	if (!this->state->adjList.count(f) || !this->state->adjList.count(s))
 		throw OperationErr("there is no such vertex(s)");
 
 	vector<Edge> edges = this->getEdgeList();
 	if (find(edges.begin(), edges.end(), Edge(f, s, w, true)) == edges.end())
 		throw OperationErr("there is no such edge");
 
-	auto it = find(this->adjList[f].begin(), this->adjList[f].end(), make_pair(s, w));
-	this->adjList[f].erase(it);
-	if (!this->directed) {
-		it = find(this->adjList[s].begin(), this->adjList[s].end(), make_pair(f, w));
-		this->adjList[s].erase(it);
-	}
+	AdjacencyMap adj = this->state->adjList;
+	eraseArc(adj, f, make_pair(s, w));
+	if (!this->state->directed)
+		eraseArc(adj, s, make_pair(f, w));
+	this->publish(adj);
 }
 
-void Graph::printToFile(string fileName) {
+void Graph::printToFile(string fileName, Exec policy) {
+	GRAPH_STATS_SCOPE("printToFile");
 	ofstream out(fileName);
 	if (!out.is_open()) throw FileNameErr(fileName);
 
-	string d = this->directed ? "directed" : "undirected";
-	string w = this->weighted ? "weighted" : "unweighted";
-	out << d << endl << w << endl;
-
-	for (auto it = this->adjList.begin(); it != this->adjList.end(); it++) {
-		out << it->first << ":";
-		vector<pair<int, int>> v = it->second;
-		for (int i = 0; i < v.size(); i++, out << ";") {
-			out << " " << v[i].first;
-			if (this->weighted)
-				out << " (" << v[i].second << ")";
-		}
-		out << endl;
-	}
+	out << (this->state->directed ? "directed" : "undirected") << "\n" << (this->state->weighted ? "weighted" : "unweighted") << "\n";
+	this->writeAdjList(out, policy);
 	out.close();
 }
 
+void Graph::writeAdjList(ostream& out, Exec policy) const {
+	vector<const AdjacencyMap::Entry*> rows;
+	rows.reserve(this->state->adjList.size());
+	for (auto it = this->state->adjList.begin(); it != this->state->adjList.end(); ++it) rows.push_back(&*it);
+	bool isWeighted = this->state->weighted;
+	writeRows(out, rows.size(), [&](size_t i, string& s) {
+		appendAdjRow(s, rows[i]->first, rows[i]->second, isWeighted);
+	}, policy);
+}
+
 int Graph::getAmountStepIn(int f) {
-	if (this->directed) {
-		if (this->vertexs.find(f) == this->vertexs.end())
+	if (this->state->directed) {
+		if (!this->state->adjList.count(f))
 			throw OperationErr("there is no such vertex");
 
 		int k = 0;
-		for (auto it = this->adjList.begin(); it != this->adjList.end(); it++) {
+		for (auto it = this->state->adjList.begin(); it != this->state->adjList.end(); it++) {
 			vector<pair<int, int>> v = it->second;
 			for (int i = 0; i < v.size(); i++) {
 				if (v[i].first == f) k++;
@@ -159,13 +338,13 @@ int Graph::getAmountStepIn(int f) {
 }
 
 vector<int> Graph::getVertexStepIn(int f) {
-	if (this->directed) {
-		if (this->vertexs.find(f) == this->vertexs.end())
+	if (this->state->directed) {
+		if (!this->state->adjList.count(f))
 			throw OperationErr("there is no such vertex");
 
 		int k = 0;
 		vector<int> stepIn;
-		for (auto it = this->adjList.begin(); it != this->adjList.end(); it++) {
+		for (auto it = this->state->adjList.begin(); it != this->state->adjList.end(); it++) {
 			vector<pair<int, int>> v = it->second;
 			if (it->first != f)
 				for (int i = 0; i < v.size(); i++)
@@ -180,18 +359,19 @@ vector<int> Graph::getVertexStepIn(int f) {
 }
 
 Graph Graph::makeCompleteGraph() {
-	if (this->weighted) throw OperationErr("graph is weighted");
+	if (this->state->weighted) throw OperationErr("graph is weighted");
 
-	Graph g1(this->directed, false);
+	Graph g1(this->state->directed, false);
 	int k = 0;
-	for (auto v : this->vertexs)
+	vector<int> vertexs = this->vertexNames();
+	for (auto v : vertexs)
 		g1.addVertex(v);
 	
-	for (auto it1 = this->vertexs.begin(); it1 != this->vertexs.end(); ++it1) {
+	for (auto it1 = vertexs.begin(); it1 != vertexs.end(); ++it1) {
 		auto it2 = it1; it2++;
-		while (it2 != this->vertexs.end()) {
+		while (it2 != vertexs.end()) {
 			g1.addEdge(*it1, *it2);
-			if (this->directed) g1.addEdge(*it2, *it1);
+			if (this->state->directed) g1.addEdge(*it2, *it1);
 			it2++;
 		}
 	}
@@ -199,103 +379,133 @@ Graph Graph::makeCompleteGraph() {
 }
 
 Graph Graph::makeCompleteGraph(int w) {
-	if (!this->weighted) throw OperationErr("graph is not weighted");
+	if (!this->state->weighted) throw OperationErr("graph is not weighted");
 
-	Graph g1(this->directed, true);
+	Graph g1(this->state->directed, true);
 	int k = 0;
-	for (auto v : this->vertexs)
+	vector<int> vertexs = this->vertexNames();
+	for (auto v : vertexs)
 		g1.addVertex(v);
 
-	for (auto it1 = this->vertexs.begin(); it1 != this->vertexs.end(); ++it1) {
+	for (auto it1 = vertexs.begin(); it1 != vertexs.end(); ++it1) {
 		auto it2 = it1; it2++;
-		while (it2 != this->vertexs.end()) {
+		while (it2 != vertexs.end()) {
 			g1.addEdge(*it1, *it2, w);
-			if (this->directed) g1.addEdge(*it2, *it1, w);
+			if (this->state->directed) g1.addEdge(*it2, *it1, w);
 			it2++;
 		}
 	}
 	return g1;
 }
 
-bool Graph::findPathDFS(int u1, int u2, int v, bool* visited, vector<int>& ans) {
-	visited[u1] = true;
-	ans.push_back(u1);
-	if (u1 == u2) return true;
-	for (int i = 0; i < this->adjList[u1].size(); ++i) {
-		int u = this->adjList[u1][i].first;
-		if (u != v && !visited[u])
-			if (this->findPathDFS(u, u2, v, visited, ans))
-				return true;
-	}
-	ans.erase(ans.end() - 1);
-	return false;
+bool Graph::allPathsThrough(int u1, int u2, int v) {
+	GRAPH_STATS_SCOPE("allPathsThrough");
+	if (!this->state->adjList.count(u1) ||
+		!this->state->adjList.count(u2) ||
+		!this->state->adjList.count(v))
+		throw OperationErr("there is no such vertex(s)");
+	shared_ptr<const Csr> g = this->getCsr();
+	return this->getAvoidIndex()->separates(g->index(u1), g->index(u2), g->index(v));
 }
 
 vector<int> Graph::findPath(int u1, int u2, int v) {
-	if (this->vertexs.find(u1) == this->vertexs.end() ||
-		this->vertexs.find(u2) == this->vertexs.end() ||
-		this->vertexs.find(v) == this->vertexs.end())
-		throw OperationErr("there is no such vertex(s)");
-	bool* visited = new bool[this->vertexs.size()];
-	for (int i = 0; i < this->vertexs.size(); ++i) visited[i] = false;
-	vector<int> path;
-	if (findPathDFS(u1, u2, v, visited, path)) return path;
-	else throw OperationErr("there is no shuch way");
-}
-
-void Graph::invDFS(int u1, bool*& visited, int shift, vector<int>& ans) {
-	if (visited[u1 - shift]) return;
-	visited[u1 - shift] = true;
-	ans.push_back(u1);
-	for (int i = 0; i < this->adjList[u1].size(); ++i) {
-		int u = this->adjList[u1][i].first;
-		if (!visited[u - shift]) {
-			invDFS(u, visited, shift, ans);
-		}
-	}
-	return;
-}
+	GRAPH_STATS_SCOPE("findPath");
+	if (this->allPathsThrough(u1, u2, v)) throw OperationErr("there is no shuch way");
+	shared_ptr<const Csr> gPtr = this->getCsr();
+	const Csr& g = *gPtr;
+	int s = g.index(u1), t = g.index(u2), skip = g.index(v);
 
-void Graph::componentDFS(int u1, int*& comp, int k, int shift) {
-	if (comp[u1 - shift] != 0) return;
-	comp[u1 - shift] = k;
-	for (int i = 0; i < this->adjList[u1].size(); ++i) {
-		int u = this->adjList[u1][i].first;
-		if (comp[u - shift] == 0) {
-			componentDFS(u, comp, k, shift);
+	//  ,         ,    
+	ScratchVector<char> visited(g.size(), 0);
+	ScratchVector<pair<int, int>> st(1, make_pair(s, g.offset[s]));
+	visited[s] = 1;
+	while (st->back().first != t) {
+		int x = st->back().first;
+		if (st->back().second == g.offset[x + 1]) {
+			st->pop_back();
+			continue;
+		}
+		int u = g.target[st->back().second++];
+		GRAPH_STATS_ADD(relaxed, 1);
+		if (u != skip && !visited[u]) {
+			visited[u] = 1;
+			GRAPH_STATS_ADD(visited, 1);
+			st->push_back(make_pair(u, g.offset[u]));
 		}
 	}
-	return;
+	vector<int> path;
+	path.reserve(st->size());
+	for (auto& f : *st) path.push_back(g.ids[f.first]);
+	return path;
 }
 
-int Graph::amountOfConnectedParts() {
-	int n = this->vertexs.size();
-	if (!this->directed) throw OperationErr("graph is not directed");
+int Graph::amountOfConnectedParts(Exec policy) {
+	GRAPH_STATS_SCOPE("amountOfConnectedParts");
+	int n = this->state->adjList.size();
+	if (!this->state->directed) throw OperationErr("graph is not directed");
 	if (!n) return 0;
-	Graph g1(true, false);
-	for (auto v : this->vertexs) g1.addVertex(v);
-	for (auto it = this->adjList.begin(); it != this->adjList.end(); it++) {
-		int u = it->first;
-		vector<pair<int, int>> v = it->second;
-		for (int i = 0; i < v.size(); i++) {
-			g1.addEdge(v[i].first, u);
+	shared_ptr<const Csr> gPtr = this->getCsr(policy), invPtr = this->getInvCsr(policy);
+	const Csr& g = *gPtr, &inv = *invPtr;
+
+	//           :
+	//    -       
+	ScratchVector<char> done(n, 0);
+	int k = 0;
+	if (policy == Exec::parallel) {
+		runFor(policy, 0, n, [&](int b, int e) {
+			for (int i = b; i < e; ++i)
+				if (!g.degree(i) || !inv.degree(i)) done[i] = 1;
+		}, 4096);
+		k = count(done->begin(), done->end(), 1);
+	}
+
+	//  :    DFS  ,   
+	ScratchVector<int> order;
+	ScratchVector<char> visited;
+	ScratchVector<pair<int, int>> st;
+	visited->assign(done->begin(), done->end());
+	for (int s = 0; s < n; ++s) {
+		if (visited[s]) continue;
+		visited[s] = 1;
+		GRAPH_STATS_ADD(visited, 1);
+		st->push_back(make_pair(s, g.offset[s]));
+		while (!st->empty()) {
+			int v = st->back().first;
+			if (st->back().second < g.offset[v + 1]) {
+				int u = g.target[st->back().second++];
+				GRAPH_STATS_ADD(relaxed, 1);
+				if (!visited[u]) {
+					visited[u] = 1;
+					GRAPH_STATS_ADD(visited, 1);
+					st->push_back(make_pair(u, g.offset[u]));
+				}
+			}
+			else {
+				order->push_back(v);
+				st->pop_back();
+			}
 		}
 	}
-	bool* visited = new bool[n];
-	for (int i = 0; i < n; ++i) visited[i] = false;
-	vector<int> ans;
-	int shift = *this->vertexs.begin();
-	for (auto v : this->vertexs)
-		g1.invDFS(v, visited, shift, ans);
-
-	int k = 1;
-	int* component = new int[n];
-	for (int i = 0; i < n; ++i) component[i] = 0;
-	vector<int> b;
-	for (int i = ans.size() - 1; i >= 0; --i) {
-		if (component[ans[i] - shift] == 0) {
-			this->componentDFS(ans[i], component, k, shift);
-			k++;
+
+	//     done:    
+	ScratchVector<int> dfs;
+	for (int i = (int)order->size() - 1; i >= 0; --i) {
+		int r = (*order)[i];
+		if (done[r]) continue;
+		k++;
+		done[r] = 1;
+		dfs->push_back(r);
+		while (!dfs->empty()) {
+			int v = dfs->back(); dfs->pop_back();
+			GRAPH_STATS_ADD(visited, 1);
+			GRAPH_STATS_ADD(relaxed, inv.degree(v));
+			for (int a = inv.offset[v]; a < inv.offset[v + 1]; ++a) {
+				int u = inv.target[a];
+				if (!done[u]) {
+					done[u] = 1;
+					dfs->push_back(u);
+				}
+			}
 		}
 	}
 	return k;
@@ -313,116 +523,119 @@ Graph makeOnEdgeList(vector<Edge> edges, bool d, bool w) {
 	return g;
 }
 
-Graph Graph::carcass() {
-	if (!this->weighted || this->directed)
+Graph Graph::carcass(Exec policy) {
+	GRAPH_STATS_SCOPE("carcass");
+	if (!this->state->weighted || this->state->directed)
 		throw OperationErr("Graph has to be weighted and undirected");
-	vector<Edge> edges = this->getEdgeList();
-	sort(edges.begin(), edges.end());
-	int n = this->adjList.size();
-	vector<int> tree;
-	for (int i = 0; i < n; ++i) tree.push_back(i);
+	vector<Edge> edges = this->getEdgeList(policy);
+	//  :       ,     
+	stableSort(policy, edges, [](const Edge& a, const Edge& b) { return a.weight < b.weight; });
+	vector<int> ids = this->vertexNames();
+	vector<int> tree(ids.size());
+	for (int i = 0; i < (int)tree.size(); ++i) tree[i] = i;
+	auto root = [&](int v) {
+		int x = lower_bound(ids.begin(), ids.end(), v) - ids.begin();
+		while (tree[x] != x) x = tree[x] = tree[tree[x]];
+		return x;
+	};
+	GRAPH_STATS_ADD(visited, ids.size());
+	GRAPH_STATS_ADD(relaxed, edges.size());
 	vector<Edge> ans;
-	int shift = *this->vertexs.begin();
 	for (auto e : edges) {
-		int a = e.first, b = e.second; 
-		if (tree[a - shift] != tree[b - shift]) {
+		int a = root(e.first), b = root(e.second);
+		if (a != b) {
 			ans.push_back(e);
-			int oldTree = tree[b - shift], newTree = tree[a - shift];
-			for (int i = 0; i < n; ++i)
-				if (tree[i] == oldTree) tree[i] = newTree;
+			tree[b] = a;
 		}
 	}
 	return makeOnEdgeList(ans, false, true);
 }
 
-void Deikstra(Graph& g, bool*& visited, vector<int>& dist, int vInd, int shift) {
-	map<int, vector<pair<int, int>>> adj = g.getAdjList();
-	for (auto l : adj[vInd + shift]) {
-		if (!visited[l.first - shift] && dist[l.first - shift] > l.second + dist[vInd])
-			dist[l.first - shift] = l.second + dist[vInd];
-	}
-	visited[vInd] = true;
-}
-
 pair<int, int> Graph::shortestWays(int u, int v1, int v2) {
-	if (!this->weighted) throw OperationErr("Graph has to be weighted");
-	if (this->vertexs.find(u) == this->vertexs.end() 
-		|| this->vertexs.find(v1) == this->vertexs.end()
-		|| this->vertexs.find(v2) == this->vertexs.end())
+	GRAPH_STATS_SCOPE("shortestWays");
+	if (!this->state->weighted) throw OperationErr("Graph has to be weighted");
+	if (!this->state->adjList.count(u) 
+		|| !this->state->adjList.count(v1)
+		|| !this->state->adjList.count(v2))
 		throw OperationErr("u, v1 or v2 do no exist in graph");
-	int n = this->vertexs.size();
-	// 
-	bool* visited = new bool[n];  vector<int> dist(n);
-	for (int i = 0; i < n; ++i) {
-		visited[i] = false;
-		dist[i] = 10000;
-	}
-	int shift = *this->vertexs.begin();
-	int vMinInd = u - shift;
-	dist[vMinInd] = 0;
-	while (true) {
-		Deikstra(*this, visited, dist, vMinInd, shift);
-		int vMinOld = vMinInd;
-		for (int i = 0; i < n; ++i)
-			if (!visited[i]) vMinInd = i;
-		if (vMinInd == vMinOld) break;
-		for (int i = 0; i < n; ++i)
-			if (!visited[i] && dist[i] < dist[vMinInd])
-				vMinInd = i;
+	shared_ptr<const Csr> gPtr = this->getCsr();
+	const Csr& g = *gPtr;
+	int s = g.index(u), t1 = g.index(v1), t2 = g.index(v2);
+
+	/*  , ,    .     ,
+	  ,        */
+	typedef pair<long long, int> Item;
+	ScratchVector<long long> dist(g.size(), unreachable);
+	ScratchVector<char> settled(g.size(), 0);
+	ScratchVector<Item> heap;
+	dist[s] = 0;
+	heap->push_back(make_pair(0LL, s));
+	bool seen1 = false, seen2 = false;
+	while (!heap->empty()) {
+		pop_heap(heap->begin(), heap->end(), greater<Item>());
+		Item top = heap->back(); heap->pop_back();
+		int v = top.second;
+		if (settled[v] || top.first > dist[v]) continue;
+		settled[v] = 1;
+		seen1 = seen1 || v == t1;
+		seen2 = seen2 || v == t2;
+		if (seen1 && seen2) break;
+		GRAPH_STATS_ADD(visited, 1);
+		GRAPH_STATS_ADD(relaxed, g.degree(v));
+		for (int a = g.offset[v]; a < g.offset[v + 1]; ++a) {
+			int x = g.target[a];
+			if (!settled[x] && dist[v] + g.weight[a] < dist[x]) {
+				dist[x] = dist[v] + g.weight[a];
+				heap->push_back(make_pair(dist[x], x));
+				push_heap(heap->begin(), heap->end(), greater<Item>());
+			}
+		}
 	}
-	
-	pair<int, int> p = make_pair(dist[v1 - shift], dist[v2 - shift]);
-	if (p.first == 10000) throw OperationErr("no way from u to v1");
-	if (p.second == 10000) throw OperationErr("no way from u to v2");
-	return p;
-}
 
-int Graph::getRadius() {	
-	if (this->directed) throw OperationErr("Graph has to be undirected");
+	if (dist[t1] == unreachable) throw OperationErr("no way from u to v1");
+	if (dist[t2] == unreachable) throw OperationErr("no way from u to v2");
+	return make_pair((int)dist[t1], (int)dist[t2]);
+}
 
-	int n = this->vertexs.size();
-	Graph g(false, true);
-	set<int> vertexes;
-	vector<Edge> thisEdges = this->getEdgeList();
-	for (auto e : thisEdges) {
-		vertexes.insert(e.first);
-		vertexes.insert(e.second);
-	}
-	for (int v : vertexes) g.addVertex(v);
-	for (auto e : thisEdges) g.addEdge(e.first, e.second, 1);
-
-	//  
-	vector<vector<int>> dist(n);
-	for (int i = 0; i < n; ++i) {
-		dist[i].resize(n);
-		for (int j = 0; j < n; j++)
-			dist[i][j] = 10000;
-	}
-	int shift = *this->vertexs.begin();
-	vector<Edge> edges = g.getEdgeList();
-	for (auto e : edges) {
-		int fir = e.first - shift, sec = e.second - shift;
-		dist[fir][sec] = e.weight;
-		if (!this->directed)
-			dist[sec][fir] = e.weight;
-	}
+int Graph::getRadius(Exec policy) {
+	GRAPH_STATS_SCOPE("getRadius");
+	if (this->state->directed) throw OperationErr("Graph has to be undirected");
 
-	for (int i = 0; i < n; ++i)
-		dist[i][i] = 0;
-	for (int k = 0; k < n; ++k)
-		for (int i = 0; i < n; i++)
-			for (int j = 0; j < n; ++j)
-				if (dist[i][j] > dist[i][k] + dist[k][j])
-					dist[i][j] = dist[i][k] + dist[k][j];
+	int n = this->state->adjList.size();
+	if (!n) throw OperationErr("Graph is empty");
+	shared_ptr<const Csr> gPtr = this->getCsr(policy);
+	const Csr& g = *gPtr;
 
+	//       ,     10000
 	vector<int> exentr(n);
-	for (int j = 0; j < n; ++j)
-		exentr[j] = *max_element(dist[j].begin(), dist[j].end());
+	runFor(policy, 0, n, [&](int b, int e) {
+		vector<int> dist(n), q(n);
+		for (int s = b; s < e; ++s) {
+			fill(dist.begin(), dist.end(), 10000);
+			dist[s] = 0;
+			int head = 0, tail = 0;
+			q[tail++] = s;
+			while (head < tail) {
+				int v = q[head++];
+				GRAPH_STATS_ADD(relaxed, g.degree(v));
+				for (int a = g.offset[v]; a < g.offset[v + 1]; ++a)
+					if (dist[g.target[a]] == 10000) {
+						dist[g.target[a]] = dist[v] + 1;
+						q[tail++] = g.target[a];
+					}
+			}
+			GRAPH_STATS_ADD(visited, tail);
+			exentr[s] = *max_element(dist.begin(), dist.end());
+		}
+	}, 8);
 	return *min_element(exentr.begin(), exentr.end());
 }
-
 void Graph::deeper (vector<int>& way, int u, int v, int tmpSum, vector<vector<int>> &ans) {
-	for (auto el : this->adjList[u]) {
+	auto row = this->state->adjList.find(u);
+	if (row == this->state->adjList.end()) return;
+	GRAPH_STATS_ADD(visited, 1);
+	GRAPH_STATS_ADD(relaxed, row->second.size());
+	for (auto el : row->second) {
 		int w = el.second;
 		int vi = el.first;
 		if (find(way.begin(), way.end(), vi) == way.end()) {
@@ -442,45 +655,94 @@ void Graph::deeper (vector<int>& way, int u, int v, int tmpSum, vector<vector<in
 	}
 }
 
-vector<vector<int>> Graph::kShortestWays(int u, int v, int k) {
-	if (!this->weighted) throw OperationErr("Graph has to be weighted");
-	if (!this->directed) throw OperationErr("Graph has to be directed");
-	if (this->vertexs.find(u) == this->vertexs.end()
-		|| this->vertexs.find(v) == this->vertexs.end())
+vector<vector<int>> Graph::kShortestWays(int u, int v, int k, Exec policy) {
+	GRAPH_STATS_SCOPE("kShortestWays");
+	if (!this->state->weighted) throw OperationErr("Graph has to be weighted");
+	if (!this->state->directed) throw OperationErr("Graph has to be directed");
+	if (!this->state->adjList.count(u)
+		|| !this->state->adjList.count(v))
 		throw OperationErr("u or v do no exist in graph");
-	int n = this->vertexs.size();
-	int n1 = n + 1;
-	vector<int> dist(n, 10000);
+	int n = this->state->adjList.size();
+	int vDist;
 	
-	//  -
-	int shift = *this->vertexs.begin();
-	dist[u - shift] = 0;
-	vector<Edge> edges = this->getEdgeList();
-	for (int i = 1; i <= n - 1; ++i)
-		for (auto e : edges) {
-			int u = e.first - shift; int v = e.second - shift;
-			int w = e.weight;
-			if (dist[u] != 10000 && dist[v] > dist[u] + w)
-				dist[v] = dist[u] + w;
+	if (policy == Exec::sequential) {
+		//  -;  -  Csr,     
+		shared_ptr<const Csr> gPtr = this->getCsr();
+		const Csr& g = *gPtr;
+		vector<int> dist(n, 10000);
+		dist[g.index(u)] = 0;
+		vector<tuple<int, int, int>> arcs;
+		for (auto& e : this->getEdgeList()) {
+			int a = g.index(e.first), b = g.index(e.second);
+			if (a >= 0 && b >= 0) arcs.push_back(make_tuple(a, b, e.weight));
 		}
-	for (auto e : edges) {
-		int u = e.first - shift; int v = e.second - shift;
-		int w = e.weight;
-		if (dist[u] != 10000 && dist[v] > dist[u] + w)
-			throw OperationErr("Graph has negative loop");
+		GRAPH_STATS_ADD(relaxed, (long long)n * arcs.size());
+		for (int i = 1; i <= n - 1; ++i)
+			for (auto& e : arcs) {
+				int a = get<0>(e), b = get<1>(e), w = get<2>(e);
+				if (dist[a] != 10000 && dist[b] > dist[a] + w)
+					dist[b] = dist[a] + w;
+			}
+		for (auto& e : arcs) {
+			int a = get<0>(e), b = get<1>(e), w = get<2>(e);
+			if (dist[a] != 10000 && dist[b] > dist[a] + w)
+				throw OperationErr("Graph has negative loop");
+		}
+		vDist = dist[g.index(v)];
 	}
-	int vInd = v - shift;
-	int sum = 10000;
-	for (int i = 1; i < n; ++i)
-		if (dist[vInd] < sum) sum = dist[vInd];
+	else {
+		/* -  :       
+		    ,     */
+		shared_ptr<const Csr> invPtr = this->getInvCsr(policy);
+		const Csr& inv = *invPtr;
+		vector<int> dist(n, 10000), next(n);
+		dist[inv.index(u)] = 0;
+		bool changed = true;
+		for (int i = 0; i < n && changed; ++i) {
+			atomic<bool> any(false);
+			runFor(policy, 0, n, [&](int b, int e) {
+				for (int x = b; x < e; ++x) {
+					next[x] = dist[x];
+					for (int a = inv.offset[x]; a < inv.offset[x + 1]; ++a) {
+						int y = inv.target[a];
+						if (dist[y] != 10000 && next[x] > dist[y] + inv.weight[a])
+							next[x] = dist[y] + inv.weight[a];
+					}
+					if (next[x] != dist[x]) any = true;
+				}
+			}, 1024);
+			GRAPH_STATS_ADD(relaxed, inv.arcs());
+			changed = any;
+			dist.swap(next);
+		}
+		if (changed) throw OperationErr("Graph has negative loop");
+		vDist = dist[inv.index(v)];
+	}
+	int sum = vDist;
 	if (sum == 10000) throw OperationErr("no way from u to v");
 
 	vector<vector<int>> ans;
 	vector<int> way;
 	way.push_back(u);
 	//  
-	int temp = sum;
-	deeper(way, u, v, sum, ans);
+	if (policy == Exec::sequential)
+		deeper(way, u, v, sum, ans);
+	else {
+		//   u       
+		const vector<pair<int, int>>& first = this->state->adjList.find(u)->second;
+		vector<vector<vector<int>>> branch(first.size());
+		runFor(policy, 0, first.size(), [&](int b, int e) {
+			for (int i = b; i < e; ++i) {
+				int vi = first[i].first, tmpSum = sum - first[i].second;
+				if (vi == u) continue;
+				vector<int> w = { u, vi };
+				if (vi == v && tmpSum == 0) branch[i].push_back(w);
+				else if (tmpSum > 0) deeper(w, vi, v, tmpSum, branch[i]);
+			}
+		});
+		for (auto& b : branch) ans.insert(ans.end(), b.begin(), b.end());
+	}
+	GRAPH_STATS_ADD(paths, ans.size());
 	if (k > ans.size()) 
 		throw OperationErr("Graph has less then k min ways from u to v");
 	vector<vector<int>> ansk;
@@ -488,86 +750,294 @@ vector<vector<int>> Graph::kShortestWays(int u, int v, int k) {
 	return ansk;
 }
 
-bool Graph::DFS(int u1, int u2, vector<bool>& visited, vector<int>& ans, int shift) {
-	visited[u1 - shift] = true;
-	ans.push_back(u1);
-	if (u1 == u2) return true;
-	for (int i = 0; i < this->adjList[u1].size(); ++i) {
-		int u = this->adjList[u1][i].first;
-		if (!visited[u - shift])
-			if (this->DFS(u, u2, visited, ans, shift))
-				return true;
-	}
-	ans.erase(ans.end() - 1);
-	return false;
-}
-
-int Graph::maxFlow(int s, int t) {
-	if (!this->weighted) throw OperationErr("Graph has to be weighted");
-	if (!this->directed) throw OperationErr("Graph has to be directed");
-	if (this->vertexs.find(s) == this->vertexs.end()
-		|| this->vertexs.find(t) == this->vertexs.end())
+int Graph::maxFlow(int s, int t, Exec policy) {
+	GRAPH_STATS_SCOPE("maxFlow");
+	if (!this->state->weighted) throw OperationErr("Graph has to be weighted");
+	if (!this->state->directed) throw OperationErr("Graph has to be directed");
+	if (!this->state->adjList.count(s)
+		|| !this->state->adjList.count(t))
 		throw OperationErr("u or v do no exist in graph");
+	if (s == t) throw OperationErr("s and t have to be different");
+
+	shared_ptr<const Csr> gPtr = this->getCsr(policy), invPtr = this->getInvCsr(policy);
+	const Csr& g = *gPtr, &inv = *invPtr;
+	int n = g.size();
+	if (g.negative) throw OperationErr("capacities have to be non-negative");
 
-	int n = this->vertexs.size();
-	Graph g = *this;
-	int shift = *this->vertexs.begin();
-	// 
-	vector<int> way; vector<Edge> edges;
-	vector<bool> visited(n, false);
-	int maxFlow = 0;
-	while (g.DFS(s, t, visited, way, shift)) {
-		int min = 0;
-		map<int, vector<pair<int, int>>> adj = g.getAdjList();
-		for (int i = 1; i < way.size(); i++) {
-			for (auto el : adj[way[i - 1]]) {
-				int fir = el.first;
-				if (fir == way[i]) 
-					edges.push_back(Edge(way[i - 1], fir, el.second, true));
+	/*  :     ,    ,
+	back[p] -    */
+	ScratchVector<int> start(n + 1, 0);
+	for (int i = 0; i < n; ++i) start[i + 1] = start[i] + g.degree(i) + inv.degree(i);
+	int m = start[n];
+	ScratchVector<int> to(m), back(m);
+	ScratchVector<long long> cap(m);
+	runFor(policy, 0, n, [&](int b, int e) {
+		for (int v = b; v < e; ++v) {
+			for (int a = g.offset[v]; a < g.offset[v + 1]; ++a) {
+				int p = start[v] + a - g.offset[v];
+				to[p] = g.target[a];
+				cap[p] = g.weight[a];
+			}
+			for (int q = inv.offset[v]; q < inv.offset[v + 1]; ++q) {
+				int p = start[v] + g.degree(v) + q - inv.offset[v];
+				int u = inv.target[q];
+				int f = start[u] + inv.arc[q] - g.offset[u];
+				to[p] = u;
+				cap[p] = 0;
+				back[p] = f;
+				back[f] = p;
 			}
 		}
-		//     
-		for (auto el : edges) {
-			int fir = el.first;
-			if (fir == way[1]) min = el.weight;
-		}
-		for (int i = 1; i < way.size(); ++i) {
-			int v = way[i];
-			for (auto el : edges)
-				if (el.first == v && min > el.weight) {
-					min = el.weight;
-					break;
-				}
-		}
-		//  
-		for (auto el : edges) {
-			int r = el.weight - min;
-			if (r == 0) {
-				g.deleteEdge(el.first, el.second, el.weight);
-				bool haveAlreadyHad = false;
-				for (auto e : adj[el.second]) {
-					if (e.first == el.first) {
-						int w = e.second;
-						int u = e.first, v = el.second;
-						g.deleteEdge(v, u, w);
-						g.addEdge(v, u, w + el.weight);
-						haveAlreadyHad = true;
-						break;
+	}, 256);
+
+	// -:      ,     
+	int src = g.index(s), snk = g.index(t);
+	ScratchVector<int> parent(n), frontier, next;
+	//      ,      parent
+	vector<atomic<int>> claim(policy == Exec::parallel ? n : 0);
+	mutex nextM;
+	long long flow = 0;
+	while (true) {
+		fill(parent->begin(), parent->end(), -1);
+		parent[src] = m;
+		frontier->assign(1, src);
+		if (policy == Exec::sequential) {
+			// frontier      
+			for (int i = 0; i < (int)frontier->size() && parent[snk] < 0; ++i) {
+				int v = (*frontier)[i];
+				GRAPH_STATS_ADD(visited, 1);
+				GRAPH_STATS_ADD(relaxed, start[v + 1] - start[v]);
+				for (int p = start[v]; p < start[v + 1]; ++p)
+					if (cap[p] > 0 && parent[to[p]] < 0) {
+						parent[to[p]] = p;
+						frontier->push_back(to[p]);
 					}
-				}
-				if (!haveAlreadyHad) g.addEdge(el.second, el.first, el.weight);
 			}
-			else {
-				g.deleteEdge(el.first, el.second, el.weight);
-				g.addEdge(el.first, el.second, r);
-				g.addEdge(el.second, el.first, min);
+		}
+		else {
+			for (auto& c : claim) c = -1;
+			claim[src] = m;
+			while (!frontier->empty() && claim[snk] < 0) {
+				next->clear();
+				runFor(policy, 0, frontier->size(), [&](int b, int e) {
+					ScratchVector<int> local;
+					for (int i = b; i < e; ++i) {
+						int v = (*frontier)[i];
+						GRAPH_STATS_ADD(visited, 1);
+						GRAPH_STATS_ADD(relaxed, start[v + 1] - start[v]);
+						for (int p = start[v]; p < start[v + 1]; ++p) {
+							int none = -1;
+							if (cap[p] > 0 && claim[to[p]].compare_exchange_strong(none, p))
+								local->push_back(to[p]);
+						}
+					}
+					lock_guard<mutex> lk(nextM);
+					next->insert(next->end(), local->begin(), local->end());
+				}, 256);
+				frontier->swap(*next);
 			}
+			for (int v = 0; v < n; ++v) parent[v] = claim[v];
+		}
+		if (parent[snk] < 0) break;
+
+		long long push = cap[parent[snk]];
+		for (int v = snk; v != src; v = to[back[parent[v]]])
+			push = min(push, cap[parent[v]]);
+		for (int v = snk; v != src; v = to[back[parent[v]]]) {
+			cap[parent[v]] -= push;
+			cap[back[parent[v]]] += push;
 		}
-		maxFlow += min;
-		way.clear();
-		edges.clear();
-		for (int i = 0; i < visited.size(); i++)
-			visited[i] = false;
+		flow += push;
+		GRAPH_STATS_ADD(paths, 1);
 	}
-	return maxFlow;
+	return (int)flow;
+}
+
+map<int, int> Graph::hopDistances(int u, Exec policy) {
+	GRAPH_STATS_SCOPE("hopDistances");
+	if (!this->state->adjList.count(u))
+		throw OperationErr("there is no such vertex");
+	shared_ptr<const Csr> g = this->getCsr(policy), inv = this->getInvCsr(policy);
+	vector<int> dist = hopBfs(*g, *inv, g->index(u), -1, policy);
+	map<int, int> ans;
+	for (size_t i = 0; i < dist.size(); ++i)
+		if (dist[i] >= 0) ans.emplace_hint(ans.end(), g->ids[i], dist[i]);
+	return ans;
+}
+
+map<int, int> Graph::hopTree(int u, Exec policy) {
+	GRAPH_STATS_SCOPE("hopTree");
+	if (!this->state->adjList.count(u))
+		throw OperationErr("there is no such vertex");
+	shared_ptr<const Csr> g = this->getCsr(policy), inv = this->getInvCsr(policy);
+	vector<int> dist = hopBfs(*g, *inv, g->index(u), -1, policy);
+	//  -          1 ,      
+	vector<int> parent(dist.size(), -1);
+	runFor(policy, 0, dist.size(), [&](int b, int e) {
+		for (int v = b; v < e; ++v) {
+			if (dist[v] <= 0) continue;
+			for (int a = inv->offset[v]; a < inv->offset[v + 1] && parent[v] < 0; ++a)
+				if (dist[inv->target[a]] == dist[v] - 1) parent[v] = inv->target[a];
+		}
+	}, 4096);
+	map<int, int> ans;
+	for (size_t i = 0; i < dist.size(); ++i)
+		if (dist[i] >= 0) ans.emplace_hint(ans.end(), g->ids[i], dist[i] ? g->ids[parent[i]] : u);
+	return ans;
+}
+
+vector<int> Graph::hopPath(int u1, int u2, Exec policy) {
+	GRAPH_STATS_SCOPE("hopPath");
+	if (!this->state->adjList.count(u1) ||
+		!this->state->adjList.count(u2))
+		throw OperationErr("there is no such vertex(s)");
+	shared_ptr<const Csr> g = this->getCsr(policy), inv = this->getInvCsr(policy);
+	int s = g->index(u1), t = g->index(u2);
+	vector<int> dist = hopBfs(*g, *inv, s, t, policy);
+	if (dist[t] < 0) throw OperationErr("there is no shuch way");
+
+	//   u2   ,    u1  
+	vector<int> path(1, u2);
+	for (int v = t; v != s;) {
+		for (int a = inv->offset[v]; a < inv->offset[v + 1]; ++a)
+			if (dist[inv->target[a]] == dist[v] - 1) {
+				v = inv->target[a];
+				break;
+			}
+		path.push_back(g->ids[v]);
+	}
+	reverse(path.begin(), path.end());
+	return path;
+}
+
+//        
+static pair<int, vector<int>> namedRoute(const Csr& g, const Route& r) {
+	if (r.length == unreachable) throw OperationErr("no way from u to v");
+	vector<int> path;
+	for (int v : r.path) path.push_back(g.ids[v]);
+	return make_pair((int)r.length, path);
+}
+
+pair<int, vector<int>> Graph::shortestWay(int u, int v) {
+	GRAPH_STATS_SCOPE("shortestWay");
+	if (!this->state->weighted) throw OperationErr("Graph has to be weighted");
+	if (!this->state->adjList.count(u)
+		|| !this->state->adjList.count(v))
+		throw OperationErr("u or v do no exist in graph");
+	shared_ptr<const Csr> g = this->getCsr(), inv = this->getInvCsr();
+	if (g->negative) throw OperationErr("Graph has negative weights");
+	return namedRoute(*g, bidirectionalDijkstra(*g, *inv, g->index(u), g->index(v)));
+}
+
+pair<int, vector<int>> Graph::shortestWayAStar(int u, int v, function<int(int, int)> h) {
+	GRAPH_STATS_SCOPE("shortestWayAStar");
+	if (!this->state->weighted) throw OperationErr("Graph has to be weighted");
+	if (!this->state->adjList.count(u)
+		|| !this->state->adjList.count(v))
+		throw OperationErr("u or v do no exist in graph");
+	shared_ptr<const Csr> g = this->getCsr();
+	if (g->negative) throw OperationErr("Graph has negative weights");
+	shared_ptr<const Landmarks> lm = atomic_load(&this->state->landmarks);
+	int t = g->index(v);
+	function<long long(int)> bound;
+	if (h) bound = [&](int x) { return (long long)h(g->ids[x], v); };
+	else if (lm) bound = [&](int x) { return lm->bound(x, t); };
+	else bound = [](int) { return 0LL; };
+	return namedRoute(*g, aStar(*g, g->index(u), t, bound));
+}
+
+void Graph::prepareLandmarks(int k, Exec policy) {
+	GRAPH_STATS_SCOPE("prepareLandmarks");
+	if (!this->state->weighted) throw OperationErr("Graph has to be weighted");
+	shared_ptr<const Csr> g = this->getCsr(policy), inv = this->getInvCsr(policy);
+	if (g->negative) throw OperationErr("Graph has negative weights");
+	atomic_store(&this->state->landmarks, make_shared<const Landmarks>(*g, *inv, k, policy));
+}
+
+pair<Graph, vector<int>> Graph::reorder(VertexOrder how, Exec policy) {
+	GRAPH_STATS_SCOPE("reorder");
+	shared_ptr<const Csr> gPtr = this->getCsr(policy), invPtr = this->getInvCsr(policy);
+	const Csr& g = *gPtr;
+	vector<int> order = vertexOrder(g, *invPtr, how);
+	int n = order.size();
+	vector<int> rank(n);
+	for (int i = 0; i < n; ++i) rank[order[i]] = i + 1;
+
+	//     ,     
+	vector<vector<pair<int, int>>> rows(n);
+	runFor(policy, 0, n, [&](int b, int e) {
+		for (int i = b; i < e; ++i) {
+			int v = order[i];
+			rows[i].reserve(g.degree(v));
+			for (int a = g.offset[v]; a < g.offset[v + 1]; ++a)
+				rows[i].push_back(make_pair(rank[g.target[a]], g.weight[a]));
+		}
+	}, 256);
+	map<int, vector<pair<int, int>>> adj;
+	for (int i = 0; i < n; ++i) adj.emplace_hint(adj.end(), i + 1, move(rows[i]));
+	for (int& v : order) v = g.ids[v];
+	return make_pair(Graph(this->state->directed, this->state->weighted, move(adj)), move(order));
+}
+
+CompressedGraph Graph::compress(bool compressWeights) {
+	GRAPH_STATS_SCOPE("compress");
+	return CompressedGraph(*this->getCsr(), this->state->directed, this->state->weighted, compressWeights);
+}
+
+ReorderedGraph::ReorderedGraph(Graph& g, VertexOrder how, Exec policy) : ReorderedGraph(g.reorder(how, policy)) {}
+
+ReorderedGraph::ReorderedGraph(pair<Graph, vector<int>> r) : g(r.first), order(move(r.second)) {
+	for (int i = 0; i < (int)this->order.size(); ++i) this->byName.push_back(make_pair(this->order[i], i + 1));
+	sort(this->byName.begin(), this->byName.end());
+}
+
+int ReorderedGraph::toOriginal(int v) {
+	if (v < 1 || v > (int)this->order.size()) throw OperationErr("there is no such vertex");
+	return this->order[v - 1];
+}
+
+int ReorderedGraph::toReordered(int v) {
+	auto it = lower_bound(this->byName.begin(), this->byName.end(), make_pair(v, 0));
+	if (it == this->byName.end() || it->first != v) throw OperationErr("there is no such vertex");
+	return it->second;
+}
+
+vector<int> ReorderedGraph::toOriginal(vector<int> path) {
+	for (int& v : path) v = this->toOriginal(v);
+	return path;
+}
+
+vector<int> ReorderedGraph::findPath(int u1, int u2, int v) {
+	return this->toOriginal(this->g.findPath(this->toReordered(u1), this->toReordered(u2), this->toReordered(v)));
+}
+
+int ReorderedGraph::amountOfConnectedParts(Exec policy) {
+	return this->g.amountOfConnectedParts(policy);
+}
+
+pair<int, int> ReorderedGraph::shortestWays(int u, int v1, int v2) {
+	return this->g.shortestWays(this->toReordered(u), this->toReordered(v1), this->toReordered(v2));
+}
+
+pair<int, vector<int>> ReorderedGraph::shortestWay(int u, int v) {
+	pair<int, vector<int>> r = this->g.shortestWay(this->toReordered(u), this->toReordered(v));
+	return make_pair(r.first, this->toOriginal(r.second));
+}
+
+int ReorderedGraph::getRadius(Exec policy) {
+	return this->g.getRadius(policy);
+}
+
+int ReorderedGraph::maxFlow(int s, int t, Exec policy) {
+	return this->g.maxFlow(this->toReordered(s), this->toReordered(t), policy);
+}
+
+map<int, int> ReorderedGraph::hopDistances(int u, Exec policy) {
+	map<int, int> ans;
+	for (auto& p : this->g.hopDistances(this->toReordered(u), policy)) ans[this->toOriginal(p.first)] = p.second;
+	return ans;
+}
+
+vector<int> ReorderedGraph::hopPath(int u1, int u2, Exec policy) {
+	return this->toOriginal(this->g.hopPath(this->toReordered(u1), this->toReordered(u2), policy));
 }
@@ -4,6 +4,15 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <memory>
+#include "Csr.h"
+#include "Executor.h"
+#include "Search.h"
+#include "AvoidIndex.h"
+#include "Order.h"
+#include "Compressed.h"
+#include "Persistent.h"
+#include "Stats.h"
 
 using namespace std;
 
@@ -11,7 +20,8 @@ using namespace std;
 class Err
 {
 public:
-	virtual void print() { cerr << "File name error\n"; }
+	virtual string message() { return "File name error"; } //     
+	void print() { cerr << this->message() << endl; }
 };
 
 class FileFormatErr : public Err
@@ -19,7 +29,7 @@ class FileFormatErr : public Err
 	string what;
 public:
 	FileFormatErr(string str) : what(str) {}
-	void print() { cerr << "Wrong file format: " << what << endl; }
+	string message() { return "Wrong file format: " + what; }
 };
 
 class FileNameErr : public Err
@@ -27,7 +37,7 @@ class FileNameErr : public Err
 	string name;
 public:
 	FileNameErr(string str) : name(str) {}
-	void print() { cerr << "Couldn't find file: " << name << endl; }
+	string message() { return "Couldn't find file: " + name; }
 };
 
 class OperationErr : public Err
@@ -35,9 +45,14 @@ class OperationErr : public Err
 	string what;
 public:
 	OperationErr(string str) : what(str) {}
-	void print() { cerr << "Incorrect operation: " << what << endl; }
+	string message() { return "Incorrect operation: " + what; }
 };
 
+//     ": ...",     
+void parseAdjLine(string s, bool weighted, int& firstV, vector<pair<int, int>>& adj);
+
+typedef PersistentMap<int, vector<pair<int, int>>> AdjacencyMap;
+
 class Edge
 {
 public:
@@ -61,21 +76,21 @@ public:
 class Graph
 {
 public:
-	Graph() {
-		this->directed = false;
-		this->weighted = false;
-		this->adjList = {};
-		this->vertexs = {};
+	Graph() : state(make_shared<State>()) {}
+
+	Graph(bool d, bool w) : state(make_shared<State>()) {
+		this->state->directed = d;
+		this->state->weighted = w;
 	}
 
-	Graph(bool d, bool w) {
-		this->directed = d;
-		this->weighted = w;
-		this->adjList = {};
-		this->vertexs = {};
+	//     :  -  ,        
+	Graph(bool d, bool w, map<int, vector<pair<int, int>>> adj) : state(make_shared<State>()) {
+		this->state->directed = d;
+		this->state->weighted = w;
+		this->state->adjList = AdjacencyMap::build(vector<pair<int, vector<pair<int, int>>>>(make_move_iterator(adj.begin()), make_move_iterator(adj.end())));
 	}
 
-	Graph(const string fileName) {
+	Graph(const string fileName, Exec policy = Exec::sequential) : state(make_shared<State>()) {
 		std::ifstream in;
 		in.open(fileName);
 		if (!in.is_open()) throw Err();
@@ -87,13 +102,13 @@ public:
 		:  (),  (), ...*/
 		string s;
 		getline(in, s);
-		if (s == "directed") this->directed = true;
-		else if (s == "undirected") this->directed = false;
+		if (s == "directed") this->state->directed = true;
+		else if (s == "undirected") this->state->directed = false;
 		else throw FileFormatErr("graph type not specified: directed/undirected");
 
 		getline(in, s);
-		if (s == "weighted") this->weighted = true;
-		else if (s == "unweighted") this->weighted = false;
+		if (s == "weighted") this->state->weighted = true;
+		else if (s == "unweighted") this->state->weighted = false;
 		else throw FileFormatErr("graph type not specified: weighted/unweighted");
 		
 		/*
@@ -103,39 +118,8 @@ public:
 		or
 		vertex: vertex; vertex; ...
 		*/
-
-		int firstV, secondV, weight = 0;
-		vector<pair<int, int>> c;
 		try {
-			while (getline(in, s)) {
-				int pos = s.find(": ");
-				firstV = stoi(s.substr(0, pos));
-				this->vertexs.insert(firstV);
-				this->adjList[firstV] = c;
-				s.erase(0, pos + 2);
-
-				if (this->weighted) {
-					pos = s.find(" ");
-					while (pos != std::string::npos) {
-						secondV = stoi(s.substr(0, pos));
-						s.erase(0, pos + 1);
-						pos = s.find(")");
-						weight = stoi(s.substr(1, pos));
-						this->adjList[firstV].push_back(make_pair(secondV, weight));
-						s.erase(0, pos + 3);
-						pos = s.find(" ");
-					}
-				}
-				else {
-					pos = s.find(";");
-					while (pos != std::string::npos) {
-						secondV = stoi(s.substr(0, pos));
-						s.erase(0, pos + 2);
-						this->adjList[firstV].push_back(make_pair(secondV, weight));
-						pos = s.find(";");
-					}
-				}
-			}
+			this->readAdjList(in, policy);
 		}
 		catch (...) {
 			throw FileFormatErr("incorrect adjList format");
@@ -144,16 +128,17 @@ public:
 		in.close();
 	}
 
-	Graph(const Graph& g) {
-		adjList = g.adjList;
-		vertexs = g.vertexs;
-		directed = g.directed;
-		weighted = g.weighted;
+	//   O(1):   ,       (. snapshot)
+	Graph(const Graph& g) : state(atomic_load(&g.state)) {}
+
+	Graph& operator=(const Graph& g) {
+		atomic_store(&this->state, atomic_load(&g.state));
+		return *this;
 	}
 
 	ostream& print(ostream& out) {
-		string d = this->directed ? "yes" : "no";
-		string w = this->weighted ? "yes" : "no";
+		string d = this->state->directed ? "yes" : "no";
+		string w = this->state->weighted ? "yes" : "no";
 		return out << "Graph info\tdirected: " << d << "\tweighted: " << w << endl;
 	}
 
@@ -161,8 +146,11 @@ public:
 		return p.print(out);
 	}
 
+	/*     O(1): ,     ,  .
+	       ,      - */
+	Graph snapshot() const { return *this; }
 	map<int, vector<pair<int, int>>> getAdjList(); //   
-	vector<Edge> getEdgeList(); //   
+	vector<Edge> getEdgeList(Exec policy = Exec::sequential); //   
 	bool isDirected(); //   
 	bool isWeighted(); //   
 
@@ -171,32 +159,90 @@ public:
 	void deleteVertex(int v); //  
 	void deleteEdge(int f, int s); //     
 	void deleteEdge(int f, int s, int w); //    
-	void printToFile(string fileName); //      
+	void printToFile(string fileName, Exec policy = Exec::sequential); //      
+	void writeAdjList(ostream& out, Exec policy = Exec::sequential) const; //       
 	int getAmountStepIn(int v); //  ,   
 	vector<int> getVertexStepIn(int v); //     
 	Graph makeCompleteGraph(); //       
 	Graph makeCompleteGraph(int w); //       
-	vector<int> findPath(int u1, int u2, int v); //    
-	int amountOfConnectedParts(); //      
-	Graph carcass(); //    
+	vector<int> findPath(int u1, int u2, int v); //   u1  u2   v,    
+	bool allPathsThrough(int u1, int u2, int v); //      u1  u2  v
+	/*       ().    
+	       ,    */
+	int amountOfConnectedParts(Exec policy = Exec::sequential);
+	Graph carcass(Exec policy = Exec::sequential); //    
 	pair<int, int> shortestWays(int u, int v1, int v2); //      u  v1  v2
-	int getRadius(); //  
-	vector<vector<int>> kShortestWays(int u, int v, int k); //  k    u  v
-	int maxFlow(int s, int t);
+	int getRadius(Exec policy = Exec::sequential); //  
+	vector<vector<int>> kShortestWays(int u, int v, int k, Exec policy = Exec::sequential); //  k    u  v
+	int maxFlow(int s, int t, Exec policy = Exec::sequential); //    s  t
+	map<int, int> hopDistances(int u, Exec policy = Exec::sequential); //     u   
+	map<int, int> hopTree(int u, Exec policy = Exec::sequential); //      u:  -> 
+	vector<int> hopPath(int u1, int u2, Exec policy = Exec::sequential); //   u1  u2    
+	pair<int, vector<int>> shortestWay(int u, int v); //      u  v  
+	// A*: h(x, v) -     x  v,    
+	pair<int, vector<int>> shortestWayAStar(int u, int v, function<int(int, int)> h = nullptr);
+	void prepareLandmarks(int k = 8, Exec policy = Exec::sequential); //    A*
+	/*     1..n,    how,  : second[i] -  
+	 i + 1.   ,    ,   */
+	pair<Graph, vector<int>> reorder(VertexOrder how, Exec policy = Exec::sequential);
+	CompressedGraph compress(bool compressWeights = true); //     
 
 private:
-	void componentDFS(int u1, int*& comp, int k, int shift); // DFS      
-	bool findPathDFS(int u1, int u2, int v, bool* visited, vector<int>& ans); //      
-	void invDFS(int u1, bool*& visited, int shift, vector<int>& ans); // DFS      
+	friend class ContractionHierarchy; //    Csr 
+
+	void readAdjList(istream& in, Exec policy); //      
+	vector<int> vertexNames() const; //   
+	shared_ptr<const Csr> getCsr(Exec policy = Exec::sequential); //   ,    
+	shared_ptr<const Csr> getInvCsr(Exec policy = Exec::sequential); //     
+	void publish(const AdjacencyMap& adj); //           
+	shared_ptr<AvoidIndex> getAvoidIndex(); //    ,    
 	void deeper(vector<int>& way, int u, int v, int tmpSum, vector<vector<int>>& ans);
-	bool DFS(int u1, int u2, vector<bool>& visited, vector<int>& ans, int shift);
-
-	bool directed;
-	bool weighted;
-	/*  -  ,
-	 first -    ,
-	second -   */
-	map<int, vector<pair<int, int>>> adjList;
-	set<int> vertexs;
+
+	/*  :       .      ,
+	     ,          */
+	struct State
+	{
+		bool directed = false;
+		bool weighted = false;
+		/*  -  ,
+		 first -    ,
+		second -  ;  -   */
+		AdjacencyMap adjList;
+		shared_ptr<const Csr> csr, invCsr; //    
+		shared_ptr<const Landmarks> landmarks;
+		shared_ptr<AvoidIndex> avoidIndex;
+	};
+	shared_ptr<State> state;
+};
+
+/*    (Graph::reorder)      .
+       */
+class ReorderedGraph
+{
+public:
+	ReorderedGraph(Graph& g, VertexOrder how, Exec policy = Exec::sequential);
+
+	Graph& graph() { return this->g; } //    1..n
+	const vector<int>& permutation() { return this->order; } //    i + 1
+	int toOriginal(int v); //    
+	int toReordered(int v); //      
+	vector<int> toOriginal(vector<int> path);
+
+	vector<int> findPath(int u1, int u2, int v);
+	int amountOfConnectedParts(Exec policy = Exec::sequential);
+	pair<int, int> shortestWays(int u, int v1, int v2);
+	pair<int, vector<int>> shortestWay(int u, int v);
+	int getRadius(Exec policy = Exec::sequential);
+	int maxFlow(int s, int t, Exec policy = Exec::sequential);
+	map<int, int> hopDistances(int u, Exec policy = Exec::sequential);
+	vector<int> hopPath(int u1, int u2, Exec policy = Exec::sequential);
+
+private:
+	ReorderedGraph(pair<Graph, vector<int>> r);
+
+	Graph g;
+	vector<int> order;
+	vector<pair<int, int>> byName; //  ( ,   )    
 };
 
+
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include "Order.h"
+#include "Stats.h"
+
+namespace {
+	//  v   ,  inv -     
+	template<class Visit>
+	void forNeighbours(const Csr& g, const Csr& inv, int v, Visit visit) {
+		for (int a = g.offset[v]; a < g.offset[v + 1]; ++a) visit(g.target[a]);
+		if (&inv != &g)
+			for (int a = inv.offset[v]; a < inv.offset[v + 1]; ++a) visit(inv.target[a]);
+	}
+
+	/*     s   ,    order; sorted -   
+	    (-).   , last -   order   */
+	int sweep(const Csr& g, const Csr& inv, const vector<int>& degree, int s, bool sorted,
+		vector<char>& seen, vector<int>& order, size_t& last) {
+		size_t levelEnd = order.size() + 1;
+		int levels = 1;
+		last = order.size();
+		seen[s] = 1;
+		order.push_back(s);
+		for (size_t i = last; i < order.size(); ++i) {
+			if (i == levelEnd) {
+				levels++;
+				last = i;
+				levelEnd = order.size();
+			}
+			size_t from = order.size();
+			forNeighbours(g, inv, order[i], [&](int u) {
+				if (!seen[u]) {
+					seen[u] = 1;
+					order.push_back(u);
+				}
+			});
+			if (sorted)
+				sort(order.begin() + from, order.end(), [&](int a, int b) {
+					return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+				});
+		}
+		return levels;
+	}
+
+	/*    s (-):     
+	  ,     */
+	int peripheral(const Csr& g, const Csr& inv, const vector<int>& degree, int s, vector<char>& seen, vector<int>& tmp) {
+		int depth = 0;
+		for (int step = 0; step < 8; ++step) {
+			tmp.clear();
+			size_t last;
+			int levels = sweep(g, inv, degree, s, false, seen, tmp, last);
+			for (int v : tmp) seen[v] = 0;
+			if (levels <= depth) break;
+			depth = levels;
+			int best = tmp[last];
+			for (size_t i = last; i < tmp.size(); ++i)
+				if (degree[tmp[i]] < degree[best]) best = tmp[i];
+			s = best;
+		}
+		return s;
+	}
+}
+
+vector<int> vertexOrder(const Csr& g, const Csr& inv, VertexOrder how) {
+	GRAPH_STATS_SCOPE("vertexOrder");
+	int n = g.size();
+	vector<int> degree(n), byDegree(n);
+	for (int v = 0; v < n; ++v) degree[v] = g.degree(v) + (&inv != &g ? inv.degree(v) : 0);
+	for (int v = 0; v < n; ++v) byDegree[v] = v;
+	GRAPH_STATS_ADD(visited, n);
+	GRAPH_STATS_ADD(relaxed, g.arcs() + (&inv != &g ? inv.arcs() : 0));
+
+	if (how == VertexOrder::degree) {
+		stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) { return degree[a] > degree[b]; });
+		return byDegree;
+	}
+
+	vector<int> order, tmp;
+	order.reserve(n);
+	vector<char> seen(n, 0);
+	if (how == VertexOrder::bfs) {
+		stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) { return degree[a] > degree[b]; });
+		size_t last;
+		for (int s : byDegree)
+			if (!seen[s]) sweep(g, inv, degree, s, false, seen, order, last);
+		return order;
+	}
+
+	//  -:     ,  -  
+	stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) { return degree[a] < degree[b]; });
+	size_t last;
+	for (int s : byDegree)
+		if (!seen[s]) sweep(g, inv, degree, peripheral(g, inv, degree, s, seen, tmp), true, seen, order, last);
+	reverse(order.begin(), order.end());
+	return order;
+}
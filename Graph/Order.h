@@ -0,0 +1,17 @@
+#include <vector>
+#include "Csr.h"
+
+using namespace std;
+
+#pragma once
+//      
+enum class VertexOrder
+{
+	rcm, //  -:    ,     
+	degree, //   :       
+	bfs //        
+};
+
+/*   : i-    -  Csr order[i].
+   , g - , inv -    (   ) */
+vector<int> vertexOrder(const Csr& g, const Csr& inv, VertexOrder how);
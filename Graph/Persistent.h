@@ -0,0 +1,182 @@
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+#pragma once
+/*      (    ).
+   O(1);       O(log n)     ,
+         .     ,
+      ,     :  
+ .        */
+template<class K, class V>
+class PersistentMap
+{
+public:
+	typedef pair<const K, V> Entry;
+
+private:
+	struct Node
+	{
+		shared_ptr<const Entry> entry;
+		shared_ptr<const Node> left, right;
+		size_t priority, size;
+	};
+	typedef shared_ptr<const Node> Link;
+
+public:
+	//    ; ,   ,   
+	class const_iterator
+	{
+	public:
+		const Entry& operator*() const { return *this->path.back()->entry; }
+		const Entry* operator->() const { return this->path.back()->entry.get(); }
+		const_iterator& operator++() {
+			const Node* t = this->path.back();
+			this->path.pop_back();
+			for (t = t->right.get(); t; t = t->left.get()) this->path.push_back(t);
+			return *this;
+		}
+		const_iterator operator++(int) {
+			const_iterator it = *this;
+			++*this;
+			return it;
+		}
+		bool operator==(const const_iterator& it) const {
+			if (this->path.empty() || it.path.empty()) return this->path.empty() == it.path.empty();
+			return this->path.back() == it.path.back();
+		}
+		bool operator!=(const const_iterator& it) const { return !(*this == it); }
+
+	private:
+		friend class PersistentMap;
+		vector<const Node*> path; //    ,      
+	};
+
+	PersistentMap() {}
+	PersistentMap(const PersistentMap& m) : root(atomic_load(&m.root)) {}
+	PersistentMap& operator=(const PersistentMap& m) {
+		atomic_store(&this->root, atomic_load(&m.root));
+		return *this;
+	}
+
+	//         O(n)
+	static PersistentMap build(vector<pair<K, V>> items) {
+		//       ;       
+		vector<shared_ptr<Node>> spine;
+		auto close = [&]() {
+			Node& t = *spine.back();
+			t.size = 1 + (t.left ? t.left->size : 0) + (t.right ? t.right->size : 0);
+			shared_ptr<Node> last = spine.back();
+			spine.pop_back();
+			return last;
+		};
+		for (auto& item : items) {
+			shared_ptr<Node> t = make_shared<Node>();
+			t->priority = priorityOf(item.first);
+			t->entry = make_shared<const Entry>(move(item.first), move(item.second));
+			shared_ptr<Node> last;
+			while (!spine.empty() && spine.back()->priority < t->priority) last = close();
+			t->left = last;
+			if (!spine.empty()) spine.back()->right = t;
+			spine.push_back(t);
+		}
+		PersistentMap m;
+		while (!spine.empty()) m.root = close();
+		return m;
+	}
+
+	size_t size() const { return this->root ? this->root->size : 0; }
+	bool empty() const { return !this->root; }
+	size_t count(const K& k) const {
+		for (const Node* t = this->root.get(); t; t = k < t->entry->first ? t->left.get() : t->right.get())
+			if (!(t->entry->first < k) && !(k < t->entry->first)) return 1;
+		return 0;
+	}
+
+	const_iterator begin() const {
+		const_iterator it;
+		for (const Node* t = this->root.get(); t; t = t->left.get()) it.path.push_back(t);
+		return it;
+	}
+	const_iterator end() const { return const_iterator(); }
+	const_iterator find(const K& k) const {
+		const_iterator it;
+		for (const Node* t = this->root.get(); t;) {
+			if (k < t->entry->first) {
+				it.path.push_back(t);
+				t = t->left.get();
+			}
+			else if (t->entry->first < k) t = t->right.get();
+			else {
+				it.path.push_back(t);
+				return it;
+			}
+		}
+		return const_iterator();
+	}
+
+	void set(const K& k, V v) { //    
+		shared_ptr<const Entry> e = make_shared<const Entry>(k, move(v));
+		Link t = this->count(k) ? replace(this->root, e) : insert(this->root, e, priorityOf(k));
+		atomic_store(&this->root, t);
+	}
+	void erase(const K& k) {
+		if (this->count(k)) atomic_store(&this->root, remove(this->root, k));
+	}
+
+private:
+	static size_t priorityOf(const K& k) {
+		//  splitmix64:       
+		unsigned long long x = hash<K>()(k) + 0x9e3779b97f4a7c15ULL;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		return (size_t)(x ^ (x >> 31));
+	}
+	static Link make(const shared_ptr<const Entry>& e, const Link& l, const Link& r, size_t priority) {
+		shared_ptr<Node> t = make_shared<Node>();
+		t->entry = e;
+		t->left = l;
+		t->right = r;
+		t->priority = priority;
+		t->size = 1 + (l ? l->size : 0) + (r ? r->size : 0);
+		return t;
+	}
+	static pair<Link, Link> split(const Link& t, const K& k) { //   k   k
+		if (!t) return pair<Link, Link>();
+		if (k < t->entry->first) {
+			pair<Link, Link> p = split(t->left, k);
+			return make_pair(p.first, make(t->entry, p.second, t->right, t->priority));
+		}
+		pair<Link, Link> p = split(t->right, k);
+		return make_pair(make(t->entry, t->left, p.first, t->priority), p.second);
+	}
+	static Link merge(const Link& a, const Link& b) {
+		if (!a) return b;
+		if (!b) return a;
+		if (a->priority > b->priority) return make(a->entry, a->left, merge(a->right, b), a->priority);
+		return make(b->entry, merge(a, b->left), b->right, b->priority);
+	}
+	static Link insert(const Link& t, const shared_ptr<const Entry>& e, size_t priority) {
+		if (!t || priority > t->priority) {
+			pair<Link, Link> p = split(t, e->first);
+			return make(e, p.first, p.second, priority);
+		}
+		if (e->first < t->entry->first) return make(t->entry, insert(t->left, e, priority), t->right, t->priority);
+		return make(t->entry, t->left, insert(t->right, e, priority), t->priority);
+	}
+	static Link replace(const Link& t, const shared_ptr<const Entry>& e) {
+		if (e->first < t->entry->first) return make(t->entry, replace(t->left, e), t->right, t->priority);
+		if (t->entry->first < e->first) return make(t->entry, t->left, replace(t->right, e), t->priority);
+		return make(e, t->left, t->right, t->priority);
+	}
+	static Link remove(const Link& t, const K& k) {
+		if (k < t->entry->first) return make(t->entry, remove(t->left, k), t->right, t->priority);
+		if (t->entry->first < k) return make(t->entry, t->left, remove(t->right, k), t->priority);
+		return merge(t->left, t->right);
+	}
+
+	Link root;
+};
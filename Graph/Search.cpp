@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <queue>
+#include "Search.h"
+#include "Arena.h"
+
+namespace {
+	typedef pair<long long, int> Item;
+	typedef priority_queue<Item, vector<Item>, greater<Item>> Heap;
+
+	//     ,    v
+	void unwind(const vector<int>& parent, int v, vector<int>& path) {
+		for (; v >= 0; v = parent[v]) path.push_back(v);
+	}
+
+	//    :   ,   priority_queue  greater
+	void pushItem(vector<Item>& heap, Item x) {
+		heap.push_back(x);
+		push_heap(heap.begin(), heap.end(), greater<Item>());
+	}
+
+	Item popItem(vector<Item>& heap) {
+		pop_heap(heap.begin(), heap.end(), greater<Item>());
+		Item top = heap.back();
+		heap.pop_back();
+		return top;
+	}
+}
+
+vector<long long> dijkstra(const Csr& g, int s) {
+	vector<long long> dist(g.size(), unreachable);
+	Heap heap;
+	dist[s] = 0;
+	heap.push(make_pair(0LL, s));
+	while (!heap.empty()) {
+		Item top = heap.top(); heap.pop();
+		int v = top.second;
+		if (top.first > dist[v]) continue;
+		GRAPH_STATS_ADD(visited, 1);
+		GRAPH_STATS_ADD(relaxed, g.degree(v));
+		for (int a = g.offset[v]; a < g.offset[v + 1]; ++a) {
+			int u = g.target[a];
+			if (dist[v] + g.weight[a] < dist[u]) {
+				dist[u] = dist[v] + g.weight[a];
+				heap.push(make_pair(dist[u], u));
+			}
+		}
+	}
+	return dist;
+}
+
+Route bidirectionalDijkstra(const Csr& g, const Csr& inv, int s, int t) {
+	int n = g.size();
+	Route r = { unreachable, {}, 0 };
+	// 0 -    s  g, 1 -   t  inv
+	const Csr* side[2] = { &g, &inv };
+	ScratchVector<long long> dist0(n, unreachable), dist1(n, unreachable);
+	ScratchVector<int> parent0(n, -1), parent1(n, -1);
+	ScratchVector<char> settled0(n, 0), settled1(n, 0);
+	ScratchVector<Item> heap0, heap1;
+	vector<long long>* dist[2] = { &*dist0, &*dist1 };
+	vector<int>* parent[2] = { &*parent0, &*parent1 };
+	vector<char>* settled[2] = { &*settled0, &*settled1 };
+	vector<Item>* heap[2] = { &*heap0, &*heap1 };
+	(*dist[0])[s] = 0; pushItem(*heap[0], make_pair(0LL, s));
+	(*dist[1])[t] = 0; pushItem(*heap[1], make_pair(0LL, t));
+	int meet = s == t ? s : -1;
+	if (meet >= 0) r.length = 0;
+
+	while (!heap[0]->empty() && !heap[1]->empty()) {
+		// :        
+		if (heap[0]->front().first + heap[1]->front().first >= r.length) break;
+		int d = heap[0]->front().first <= heap[1]->front().first ? 0 : 1;
+		vector<long long>& here = *dist[d], &there = *dist[1 - d];
+		Item top = popItem(*heap[d]);
+		int v = top.second;
+		if ((*settled[d])[v]) continue;
+		(*settled[d])[v] = 1;
+		r.settled++;
+		const Csr& c = *side[d];
+		GRAPH_STATS_ADD(visited, 1);
+		GRAPH_STATS_ADD(relaxed, c.degree(v));
+		for (int a = c.offset[v]; a < c.offset[v + 1]; ++a) {
+			int u = c.target[a];
+			long long du = here[v] + c.weight[a];
+			if (du < here[u]) {
+				here[u] = du;
+				(*parent[d])[u] = v;
+				pushItem(*heap[d], make_pair(du, u));
+			}
+			if (there[u] < unreachable && here[u] + there[u] < r.length) {
+				r.length = here[u] + there[u];
+				meet = u;
+			}
+		}
+	}
+	if (meet < 0) return r;
+	unwind(*parent[0], meet, r.path);
+	reverse(r.path.begin(), r.path.end());
+	unwind(*parent[1], (*parent[1])[meet], r.path);
+	return r;
+}
+
+Route aStar(const Csr& g, int s, int t, const function<long long(int)>& h) {
+	int n = g.size();
+	Route r = { unreachable, {}, 0 };
+	ScratchVector<long long> dist(n, unreachable);
+	ScratchVector<int> parent(n, -1);
+	ScratchVector<Item> heap;
+	dist[s] = 0;
+	pushItem(*heap, make_pair(h(s), s));
+	while (!heap->empty()) {
+		Item top = popItem(*heap);
+		int v = top.second;
+		if (top.first - h(v) > dist[v]) continue;
+		r.settled++;
+		if (v == t) break;
+		GRAPH_STATS_ADD(visited, 1);
+		GRAPH_STATS_ADD(relaxed, g.degree(v));
+		for (int a = g.offset[v]; a < g.offset[v + 1]; ++a) {
+			int u = g.target[a];
+			if (dist[v] + g.weight[a] < dist[u]) {
+				dist[u] = dist[v] + g.weight[a];
+				parent[u] = v;
+				pushItem(*heap, make_pair(dist[u] + h(u), u));
+			}
+		}
+	}
+	if (dist[t] == unreachable) return r;
+	r.length = dist[t];
+	unwind(*parent, t, r.path);
+	reverse(r.path.begin(), r.path.end());
+	return r;
+}
+
+Landmarks::Landmarks(const Csr& g, const Csr& inv, int k, Exec policy) {
+	int n = g.size();
+	k = min(k, n);
+	vector<long long> nearest(n, unreachable);
+	int next = 0;
+	for (int i = 0; i < k; ++i) {
+		this->marks.push_back(next);
+		this->from.push_back(dijkstra(g, next));
+		for (int v = 0; v < n; ++v) nearest[v] = min(nearest[v], this->from.back()[v]);
+		//   -     ,    
+		next = -1;
+		for (int v = 0; v < n; ++v)
+			if (find(this->marks.begin(), this->marks.end(), v) == this->marks.end()
+				&& (next < 0 || nearest[v] > nearest[next]))
+				next = v;
+		if (next < 0) break;
+	}
+	this->to.resize(this->marks.size());
+	runFor(policy, 0, this->marks.size(), [&](int b, int e) {
+		for (int i = b; i < e; ++i) this->to[i] = dijkstra(inv, this->marks[i]);
+	});
+}
+
+long long Landmarks::bound(int v, int t) const {
+	long long best = 0;
+	for (size_t k = 0; k < this->marks.size(); ++k) {
+		// d(v, t) >= d(v, L) - d(t, L)  d(v, t) >= d(L, t) - d(L, v)
+		if (this->to[k][v] < unreachable && this->to[k][t] < unreachable)
+			best = max(best, this->to[k][v] - this->to[k][t]);
+		if (this->from[k][t] < unreachable && this->from[k][v] < unreachable)
+			best = max(best, this->from[k][t] - this->from[k][v]);
+	}
+	return best;
+}
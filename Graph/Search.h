@@ -0,0 +1,36 @@
+#include <functional>
+#include <vector>
+#include "Csr.h"
+#include "Executor.h"
+
+using namespace std;
+
+#pragma once
+const long long unreachable = 1LL << 60;
+
+//       ( -  Csr)
+struct Route
+{
+	long long length; // unreachable,   
+	vector<int> path;
+	int settled; //     
+};
+
+/*    A* (ALT):       ,
+           */
+class Landmarks
+{
+public:
+	vector<int> marks;
+	vector<vector<long long>> from; // from[k][v] -    k  v
+	vector<vector<long long>> to; // to[k][v] -   v   k
+
+	//    :   -      
+	Landmarks(const Csr& g, const Csr& inv, int k, Exec policy = Exec::sequential);
+	long long bound(int v, int t) const; //     v  t
+};
+
+vector<long long> dijkstra(const Csr& g, int s); //   s   
+Route bidirectionalDijkstra(const Csr& g, const Csr& inv, int s, int t);
+// h(v) -     v  t;     
+Route aStar(const Csr& g, int s, int t, const function<long long(int)>& h);
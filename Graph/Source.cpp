@@ -1,33 +1,42 @@
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
 #include "Graph.h"
+#include "ContractionHierarchy.h"
+#include "Generators.h"
+#include "Writer.h"
 
 using namespace std;
 
 //    
-void printAdjList(Graph g) {
-    map<int, vector<pair<int, int>>> adj = g.getAdjList();
-    cout << "Adjacency List" << endl;
-    for (auto it = adj.begin(); it != adj.end(); it++) {
-        cout << it->first << ":";
-        vector<pair<int, int>> v = it->second;
-        for (int i = 0; i < v.size(); i++, cout << ";") {
-            cout << " " << v[i].first;
-            if (g.isWeighted())
-                cout << " (" << v[i].second << ")";
-        }
-        cout << endl;
-    }
+void printAdjList(const Graph& g) {
+    cout << "Adjacency List\n";
+    g.writeAdjList(cout, Exec::parallel);
+    cout.flush();
 }
 
 //    
-void printEdgeList(Graph g) {
-    vector<Edge> edges = g.getEdgeList();
-    string razd = g.isDirected() ? "->" : "-";
-    cout << "Edges List" << endl;
-    for (auto it = edges.begin(); it != edges.end(); it++, cout << endl) {
-        cout << it->first << razd << it->second;
-        if (it->isWeighted) cout << " (" << it->weight << ")";
-    }
+void printEdgeList(Graph& g) {
+    vector<Edge> edges = g.getEdgeList(Exec::parallel);
+    const char* razd = g.isDirected() ? "->" : "-";
+    cout << "Edges List\n";
+    writeRows(cout, edges.size(), [&](size_t i, string& s) {
+        const Edge& e = edges[i];
+        appendInt(s, e.first);
+        s += razd;
+        appendInt(s, e.second);
+        if (e.isWeighted) {
+            s += " (";
+            appendInt(s, e.weight);
+            s += ')';
+        }
+        s += '\n';
+    }, Exec::parallel);
     cout << endl;
 }
 
@@ -37,7 +46,304 @@ void printVector(vector<int> v) {
     cout << "\n";
 }
 
-int main() {
+//              
+void compareHierarchy(Graph& g, int queries, string fileName) {
+    auto start = chrono::steady_clock::now();
+    ContractionHierarchy ch(g, Exec::parallel);
+    double build = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ch.save(fileName);
+    cout << "hierarchy: " << ch.size() << " vertexes, " << ch.shortcuts() << " shortcuts, built in "
+        << build << " s, saved to " << fileName << "\n";
+
+    map<int, vector<pair<int, int>>> adj = g.getAdjList();
+    vector<int> names;
+    for (auto it = adj.begin(); it != adj.end(); it++) names.push_back(it->first);
+    if (names.empty() || queries <= 0) return;
+    mt19937 rng(1);
+    double chTime = 0, dijkstraTime = 0;
+    int mismatches = 0;
+    for (int i = 0; i < queries; ++i) {
+        int u = names[rng() % names.size()], v = names[rng() % names.size()];
+        int a = -1, b = -1;
+        start = chrono::steady_clock::now();
+        try { a = ch.distance(u, v); }
+        catch (Err&) {}
+        chTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        try { b = g.shortestWays(u, v, v).first; }
+        catch (Err&) {}
+        dijkstraTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (a != b) mismatches++;
+    }
+    cout << "avg query, us: hierarchy " << chTime / queries * 1e6
+        << ", dijkstra " << dijkstraTime / queries * 1e6 << "\n"
+        << "mismatches: " << mismatches << "\n";
+}
+
+//    ,      
+Graph generateGraph(string fileName) {
+    int kind, a, b, c;
+    unsigned long long seed;
+    cout << "1 - Erdos-Renyi (n, m)\n2 - R-MAT (scale, edgeFactor)\n3 - Barabasi-Albert (n, m)\n"
+        << "4 - grid (rows, cols)\n5 - layered flow network (layers, width, degree)\n";
+    cin >> kind;
+    cout << "Enter parameters and seed: ";
+    GraphGenerator gen = GraphGenerator::erdosRenyi(2, 0);
+    switch (kind) {
+    case 1: cin >> a >> b >> seed; gen = GraphGenerator::erdosRenyi(a, b, seed); break;
+    case 2: cin >> a >> b >> seed; gen = GraphGenerator::rmat(a, b, seed); break;
+    case 3: cin >> a >> b >> seed; gen = GraphGenerator::barabasiAlbert(a, b, seed); break;
+    case 4: cin >> a >> b >> seed; gen = GraphGenerator::grid(a, b, seed); break;
+    case 5: cin >> a >> b >> c >> seed; gen = GraphGenerator::layeredFlow(a, b, c, seed); break;
+    default: throw OperationErr("there is no such generator");
+    }
+    if (kind != 5) {
+        cout << "Directed? (1/0) ";
+        cin >> a;
+        gen.directed(a != 0);
+    }
+    gen.write(fileName, Exec::parallel);
+    return Graph(fileName, Exec::parallel);
+}
+
+/*  :     ,      # .
+      :      
+ "error <> < >".         */
+struct Command {
+    string name;
+    vector<int> args;
+    string file; //  load  save
+    string error; //   
+};
+
+//   ->   ;  dijkstra, addedge  deledge    
+const map<string, int> batchArity = {
+    { "load", 0 }, { "save", 0 }, { "addvertex", 1 }, { "addedge", 2 }, { "delvertex", 1 }, { "deledge", 2 },
+    { "path", 3 }, { "scc", 0 }, { "mst", 0 }, { "dijkstra", 2 }, { "radius", 0 }, { "kpaths", 3 }, { "maxflow", 2 } };
+
+//   ; false     
+bool parseCommand(const string& line, Command& c) {
+    stringstream ss(line);
+    string tok;
+    if (!(ss >> c.name) || c.name[0] == '#') return false;
+    auto it = batchArity.find(c.name);
+    if (it == batchArity.end()) {
+        c.error = "unknown command";
+        return true;
+    }
+    if (c.name == "load" || c.name == "save") {
+        if (!(ss >> c.file) || ss >> tok) c.error = "expected file name";
+        return true;
+    }
+    while (ss >> tok) {
+        try {
+            size_t pos;
+            c.args.push_back(stoi(tok, &pos));
+            if (pos != tok.size()) throw invalid_argument(tok);
+        }
+        catch (exception&) {
+            c.error = "bad argument " + tok;
+            return true;
+        }
+    }
+    int n = c.args.size(), need = it->second;
+    bool optional = c.name == "dijkstra" || c.name == "deledge" || c.name == "addedge";
+    if (n != need && !(optional && n == need + 1))
+        c.error = "expected " + to_string(need) + " arguments";
+    return true;
+}
+
+void appendPath(string& out, const vector<int>& path) {
+    for (int v : path) out += " " + to_string(v);
+}
+
+//          out
+void runCommand(Graph& g, const Command& c, Exec policy, string& out) {
+    const vector<int>& a = c.args;
+    string line = c.name;
+    try {
+        if (!c.error.empty()) throw OperationErr(c.error);
+        if (c.name == "load") {
+            g = Graph(c.file, policy);
+            line += " ok";
+        }
+        else if (c.name == "save") {
+            g.printToFile(c.file);
+            line += " ok";
+        }
+        else if (c.name == "addvertex") {
+            g.addVertex(a[0]);
+            line += " ok";
+        }
+        else if (c.name == "addedge") {
+            g.addEdge(a[0], a[1], a.size() > 2 ? a[2] : 0);
+            line += " ok";
+        }
+        else if (c.name == "delvertex") {
+            g.deleteVertex(a[0]);
+            line += " ok";
+        }
+        else if (c.name == "deledge") {
+            if (a.size() > 2) g.deleteEdge(a[0], a[1], a[2]);
+            else g.deleteEdge(a[0], a[1]);
+            line += " ok";
+        }
+        else if (c.name == "path") appendPath(line, g.findPath(a[0], a[1], a[2]));
+        else if (c.name == "scc") line += " " + to_string(g.amountOfConnectedParts(policy));
+        else if (c.name == "mst") {
+            //  ,      u v w
+            vector<Edge> edges = g.carcass(policy).getEdgeList();
+            long long total = 0;
+            string list;
+            for (auto& e : edges) {
+                total += e.weight;
+                list += " " + to_string(e.first) + " " + to_string(e.second) + " " + to_string(e.weight);
+            }
+            line += " " + to_string(total) + " " + to_string(edges.size()) + list;
+        }
+        else if (c.name == "dijkstra") {
+            // dijkstra u v -   , dijkstra u v1 v2 -    
+            if (a.size() > 2) {
+                pair<int, int> p = g.shortestWays(a[0], a[1], a[2]);
+                line += " " + to_string(p.first) + " " + to_string(p.second);
+            }
+            else {
+                pair<int, vector<int>> p = g.shortestWay(a[0], a[1]);
+                line += " " + to_string(p.first);
+                appendPath(line, p.second);
+            }
+        }
+        else if (c.name == "radius") line += " " + to_string(g.getRadius(policy));
+        else if (c.name == "kpaths") {
+            //   " ;"
+            vector<vector<int>> ways = g.kShortestWays(a[0], a[1], a[2], policy);
+            for (size_t i = 0; i < ways.size(); ++i) {
+                if (i) line += " ;";
+                appendPath(line, ways[i]);
+            }
+        }
+        else if (c.name == "maxflow") line += " " + to_string(g.maxFlow(a[0], a[1], policy));
+    }
+    catch (Err& e) {
+        line = "error " + c.name + " " + e.message();
+    }
+    catch (exception& e) {
+        line = "error " + c.name + " " + e.what();
+    }
+    out += line;
+    out += '\n';
+}
+
+/*      .  pipeline      ,
+  ,         */
+void runBatch(istream& in, ostream& out, bool pipeline, Exec policy) {
+    const size_t flushAt = 1 << 16, batchSize = 256, maxQueued = 64;
+    Graph g;
+    string buffer, line;
+    auto flush = [&]() {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    };
+
+    if (!pipeline) {
+        while (getline(in, line)) {
+            Command c;
+            if (!parseCommand(line, c)) continue;
+            runCommand(g, c, policy, buffer);
+            if (buffer.size() >= flushAt) flush();
+        }
+        flush();
+        out.flush();
+        return;
+    }
+
+    deque<vector<Command>> queue;
+    bool done = false, stopped = false;
+    mutex m;
+    condition_variable ready, space;
+    thread reader([&]() {
+        vector<Command> batch;
+        string s;
+        // false,        
+        auto push = [&]() {
+            unique_lock<mutex> lk(m);
+            space.wait(lk, [&] { return stopped || queue.size() < maxQueued; });
+            if (stopped) return false;
+            queue.push_back(move(batch));
+            batch.clear();
+            ready.notify_one();
+            return true;
+        };
+        bool open = true;
+        while (open && getline(in, s)) {
+            Command c;
+            if (!parseCommand(s, c)) continue;
+            batch.push_back(move(c));
+            if (batch.size() == batchSize) open = push();
+        }
+        if (open && !batch.empty()) push();
+        lock_guard<mutex> lk(m);
+        done = true;
+        ready.notify_one();
+    });
+    //        ,     
+    struct ReaderGuard {
+        thread& reader;
+        mutex& m;
+        bool& stopped;
+        condition_variable& space;
+        ~ReaderGuard() {
+            {
+                lock_guard<mutex> lk(m);
+                stopped = true;
+            }
+            space.notify_all();
+            reader.join();
+        }
+    } guard = { reader, m, stopped, space };
+    while (true) {
+        vector<Command> batch;
+        {
+            unique_lock<mutex> lk(m);
+            ready.wait(lk, [&] { return done || !queue.empty(); });
+            if (queue.empty()) break;
+            batch = move(queue.front());
+            queue.pop_front();
+            space.notify_one();
+        }
+        for (auto& c : batch) runCommand(g, c, policy, buffer);
+        if (buffer.size() >= flushAt) flush();
+    }
+    flush();
+    out.flush();
+}
+
+int main(int argc, char** argv) {
+    // Graph --batch [script|-] [--pipeline] [--parallel]:       
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        string script = "-";
+        bool pipeline = false;
+        Exec policy = Exec::sequential;
+        for (int i = 2; i < argc; ++i) {
+            string arg = argv[i];
+            if (arg == "--pipeline") pipeline = true;
+            else if (arg == "--parallel") policy = Exec::parallel;
+            else script = arg;
+        }
+        ios::sync_with_stdio(false);
+        if (script == "-") {
+            runBatch(cin, cout, pipeline, policy);
+            return 0;
+        }
+        ifstream in(script);
+        if (!in.is_open()) {
+            FileNameErr(script).print();
+            return 1;
+        }
+        runBatch(in, cout, pipeline, policy);
+        return 0;
+    }
+
     string s = "19-1.txt";
     // cout << "Enter fileName: ";
     // cin >> s;
@@ -67,7 +373,12 @@ int main() {
             << "16 - print lenghts of shortest ways from u to v1 and v2\n"
             << "17 - find radius of the graph\n"
             << "18 - find k shortest ways from u to v\n"
-            << "19 - find max flow from s to t\n";
+            << "19 - find max flow from s to t\n"
+            << "20 - shortest way from u1 to u2 by number of edges\n"
+            << "21 - shortest way from u to v (bidirectional Dijkstra)\n"
+            << "22 - build contraction hierarchy and compare it with Dijkstra\n"
+            << "23 - generate synthetic graph into file\n"
+            << "24 - print operation statistics\n";
         cin >> action;
         int fir, sec, third, weight;
         vector<int> v;
@@ -210,6 +521,45 @@ int main() {
                 cout << "max flow from s to t: " << g.maxFlow(fir, sec) << endl;
                 break;
             }
+            case 20:
+                // 20 -        
+                cout << "Enter vertexes u1, u2: ";
+                cin >> fir >> sec;
+                printVector(g.hopPath(fir, sec, Exec::parallel));
+                break;
+            case 21: {
+                // 21 -       
+                cout << "Enter vertexes u, v: ";
+                cin >> fir >> sec;
+                pair<int, vector<int>> p = g.shortestWay(fir, sec);
+                cout << "length: " << p.first << "\n";
+                printVector(p.second);
+                break;
+            }
+            case 22:
+                // 22 -  : ,     
+                cout << "Enter fileName for the hierarchy: ";
+                cin >> s;
+                cout << "Enter amount of queries: ";
+                cin >> fir;
+                compareHierarchy(g, fir, s);
+                break;
+            case 23:
+                // 23 -  :     
+                cout << "Enter fileName: ";
+                cin >> s;
+                g = generateGraph(s);
+                cout << g << "vertexs: " << g.getAdjList().size() << "\n";
+                break;
+            case 24:
+                // 24 -    (   GRAPH_STATS)
+                GraphStats::print(cout);
+                if (GraphStats::enabled()) {
+                    cout << "Reset statistics? (1/0) ";
+                    cin >> fir;
+                    if (fir) GraphStats::reset();
+                }
+                break;
             default:
                 cout << "\nHave no operation with such name\n";
                 break;
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "Stats.h"
+
+namespace {
+	mutex registryM;
+
+	map<string, unique_ptr<GraphStats::Method>>& registry() {
+		static map<string, unique_ptr<GraphStats::Method>> methods;
+		return methods;
+	}
+
+	thread_local GraphStats::Method* currentMethod = nullptr;
+}
+
+GraphStats::Scope::Scope(Method& m) : method(m), outer(currentMethod), start(chrono::steady_clock::now()) {
+	currentMethod = &m;
+}
+
+GraphStats::Scope::~Scope() {
+	long long ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - this->start).count();
+	this->method.calls.fetch_add(1, memory_order_relaxed);
+	this->method.nanoseconds.fetch_add(ns, memory_order_relaxed);
+	currentMethod = this->outer;
+}
+
+GraphStats::Bind::Bind(Method* m) : outer(currentMethod) {
+	currentMethod = m;
+}
+
+GraphStats::Bind::~Bind() {
+	currentMethod = this->outer;
+}
+
+bool GraphStats::enabled() {
+#ifdef GRAPH_STATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+GraphStats::Method& GraphStats::method(const char* name) {
+	lock_guard<mutex> lk(registryM);
+	unique_ptr<Method>& m = registry()[name];
+	if (!m) {
+		m.reset(new Method());
+		m->name = name;
+		m->calls = m->nanoseconds = m->visited = m->relaxed = m->paths = m->bytes = 0;
+	}
+	return *m;
+}
+
+GraphStats::Method* GraphStats::current() {
+	return currentMethod;
+}
+
+void GraphStats::add(atomic<long long> Method::* counter, long long value) {
+	if (currentMethod) (currentMethod->*counter).fetch_add(value, memory_order_relaxed);
+}
+
+vector<MethodReport> GraphStats::report() {
+	lock_guard<mutex> lk(registryM);
+	vector<MethodReport> ans;
+	for (auto& p : registry()) {
+		const Method& m = *p.second;
+		if (!m.calls) continue;
+		ans.push_back({ m.name, m.calls, m.nanoseconds * 1e-9, m.visited, m.relaxed, m.paths, m.bytes });
+	}
+	return ans;
+}
+
+void GraphStats::reset() {
+	lock_guard<mutex> lk(registryM);
+	for (auto& p : registry()) {
+		Method& m = *p.second;
+		m.calls = m.nanoseconds = m.visited = m.relaxed = m.paths = m.bytes = 0;
+	}
+}
+
+void GraphStats::print(ostream& out) {
+	if (!enabled()) {
+		out << "statistics are disabled, rebuild with GRAPH_STATS\n";
+		return;
+	}
+	char buf[256];
+	snprintf(buf, sizeof(buf), "%-24s %10s %12s %14s %14s %10s %14s\n",
+		"method", "calls", "total ms", "visited", "relaxed", "paths", "bytes");
+	out << buf;
+	for (auto& r : report()) {
+		snprintf(buf, sizeof(buf), "%-24s %10lld %12.3f %14lld %14lld %10lld %14lld\n",
+			r.name.c_str(), r.calls, r.seconds * 1e3, r.visited, r.relaxed, r.paths, r.bytes);
+		out << buf;
+	}
+}
@@ -0,0 +1,83 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#pragma once
+/*   :  , ,  ,  ,
+  (  maxFlow)  ,    .
+     GRAPH_STATS (   Debug   CMake GRAPH_STATS),
+       .      ,
+  ;     ,    */
+
+//    
+struct MethodReport
+{
+	string name;
+	long long calls;
+	double seconds;
+	long long visited; //  
+	long long relaxed; //    
+	long long paths; //  
+	long long bytes; //  
+};
+
+class GraphStats
+{
+public:
+	struct Method
+	{
+		string name;
+		atomic<long long> calls, nanoseconds, visited, relaxed, paths, bytes;
+	};
+
+	//   :     ,      
+	class Scope
+	{
+	public:
+		explicit Scope(Method& m);
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		Method& method;
+		Method* outer;
+		chrono::steady_clock::time_point start;
+	};
+
+	//      ,    (  )
+	class Bind
+	{
+	public:
+		explicit Bind(Method* m);
+		~Bind();
+		Bind(const Bind&) = delete;
+		Bind& operator=(const Bind&) = delete;
+
+	private:
+		Method* outer;
+	};
+
+	static bool enabled(); //     
+	static vector<MethodReport> report(); // ,    ,  
+	static void reset();
+	static void print(ostream& out);
+
+	static Method& method(const char* name); //  ,    
+	static Method* current(); //     nullptr
+	static void add(atomic<long long> Method::* counter, long long value);
+};
+
+#ifdef GRAPH_STATS
+#define GRAPH_STATS_SCOPE(name) \
+	static GraphStats::Method& graphStatsMethod = GraphStats::method(name); \
+	GraphStats::Scope graphStatsScope(graphStatsMethod)
+#define GRAPH_STATS_ADD(counter, value) GraphStats::add(&GraphStats::Method::counter, (long long)(value))
+#else
+#define GRAPH_STATS_SCOPE(name)
+#define GRAPH_STATS_ADD(counter, value)
+#endif
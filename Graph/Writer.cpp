@@ -0,0 +1,24 @@
+#include <charconv>
+#include "Writer.h"
+
+void appendInt(string& s, long long x) {
+	char buf[24];
+	auto r = to_chars(buf, buf + sizeof(buf), x);
+	s.append(buf, r.ptr);
+}
+
+void appendAdjRow(string& s, int v, const vector<pair<int, int>>& row, bool weighted) {
+	appendInt(s, v);
+	s += ':';
+	for (auto& p : row) {
+		s += ' ';
+		appendInt(s, p.first);
+		if (weighted) {
+			s += " (";
+			appendInt(s, p.second);
+			s += ')';
+		}
+		s += ';';
+	}
+	s += '\n';
+}
@@ -0,0 +1,52 @@
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Executor.h"
+
+using namespace std;
+
+#pragma once
+/*    :   to_chars   -,
+     write     */
+
+void appendInt(string& s, long long x); //    
+//       Graph: "v: u (w); u (w);"   
+void appendAdjRow(string& s, int v, const vector<pair<int, int>>& row, bool weighted);
+
+/*   out count , format(i, s)   s i- .   
+ rowsPerPiece;           ,
+       */
+template<class Format>
+void writeRows(ostream& out, size_t count, Format format, Exec policy = Exec::sequential, int rowsPerPiece = 4096) {
+	const size_t flushAt = 1 << 20;
+	if (policy == Exec::sequential) {
+		string s;
+		s.reserve(flushAt + 4096);
+		for (size_t i = 0; i < count; ++i) {
+			format(i, s);
+			if (s.size() >= flushAt) {
+				out.write(s.data(), s.size());
+				s.clear();
+			}
+		}
+		out.write(s.data(), s.size());
+		return;
+	}
+
+	size_t pieces = (count + rowsPerPiece - 1) / rowsPerPiece;
+	int window = ThreadPool::instance().size() * 4;
+	vector<string> text(min<size_t>(window, pieces));
+	for (size_t p0 = 0; p0 < pieces; p0 += window) {
+		int n = (int)min<size_t>(window, pieces - p0);
+		runFor(policy, 0, n, [&](int b, int e) {
+			for (int i = b; i < e; ++i) {
+				string& s = text[i];
+				s.clear();
+				size_t from = (p0 + i) * rowsPerPiece, to = min(count, from + rowsPerPiece);
+				for (size_t r = from; r < to; ++r) format(r, s);
+			}
+		});
+		for (int i = 0; i < n; ++i) out.write(text[i].data(), text[i].size());
+	}
+}
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include "BasicGraph.h"
+
+using namespace std;
+
+/*  BasicGraph   (  ,   )  Graph   :
+   ,          */
+
+int failures = 0;
+
+void check(bool ok, const string& what) {
+    if (ok) return;
+    failures++;
+    cerr << "FAIL: " << what << endl;
+}
+
+//     Graph, -1   
+long long graphDistance(Graph& g, int u, int v) {
+    try {
+        if (g.isWeighted()) return g.shortestWay(u, v).first;
+        return (long long)g.hopPath(u, v).size() - 1;
+    }
+    catch (Err&) {
+        return -1;
+    }
+}
+
+template<class Basic>
+long long basicDistance(const Basic& b, int u, int v) {
+    try {
+        pair<typename Basic::Distance, vector<int>> r = b.shortestPath(u, v);
+        check((long long)r.second.size() >= 1 && r.second.front() == u && r.second.back() == v, "path ends");
+        return (long long)r.first;
+    }
+    catch (Err&) {
+        return -1;
+    }
+}
+
+//    Graph:    ,   -     
+int graphComponents(Graph& g) {
+    if (g.isDirected()) return g.amountOfConnectedParts();
+    set<int> seen;
+    int k = 0;
+    for (auto& row : g.getAdjList()) {
+        if (seen.count(row.first)) continue;
+        k++;
+        for (auto& d : g.hopDistances(row.first)) seen.insert(d.first);
+    }
+    return k;
+}
+
+template<class Basic>
+void compare(Graph& g, const Basic& b, mt19937& rng, int n, const string& kind) {
+    check(b.toGraph().getAdjList() == g.getAdjList(), kind + ": toGraph");
+    check(b.components() == graphComponents(g), kind + ": components");
+    if constexpr (!Basic::directed) {
+        //    n - k ,         Graph
+        Basic forest = b.spanningForest();
+        check((int)forest.edgeList().size() == b.vertexCount() - graphComponents(g), kind + ": spanningForest size");
+        if constexpr (Basic::weighted) {
+            long long mine = 0, theirs = 0;
+            for (auto& e : forest.edgeList()) mine += e.weight;
+            for (auto& e : g.carcass().getEdgeList()) theirs += e.weight;
+            check(mine == theirs, kind + ": spanningForest weight");
+        }
+    }
+    for (int q = 0; q < 20; ++q) {
+        int u = rng() % n, v = rng() % n;
+        if (!b.hasVertex(u) || !b.hasVertex(v)) continue;
+        check(basicDistance(b, u, v) == graphDistance(g, u, v), kind + ": shortestPath " + to_string(u) + " " + to_string(v));
+    }
+}
+
+template<class Basic>
+void run(unsigned seed, const string& kind) {
+    mt19937 rng(seed);
+    int n = 40;
+    Graph g(Basic::directed, Basic::weighted);
+    for (int v = 0; v < n; ++v) g.addVertex(v);
+    for (int e = 0; e < 60; ++e) {
+        int f = rng() % n, s = rng() % n;
+        if (f == s) continue;
+        try {
+            g.addEdge(f, s, Basic::weighted ? 1 + rng() % 9 : 0);
+        }
+        catch (Err&) {}
+    }
+    Basic b(g);
+    compare(g, b, rng, n, kind);
+
+    //    ,       
+    for (int step = 0; step < 20; ++step) {
+        int f = rng() % n, s = rng() % n;
+        if (step % 5 == 4) {
+            if (!b.hasVertex(f)) continue;
+            g.deleteVertex(f);
+            b.deleteVertex(f);
+        }
+        else {
+            if (f == s || !b.hasVertex(f) || !b.hasVertex(s)) continue;
+            //   Graph  BasicGraph  -,   
+            bool exists = false;
+            for (auto& a : b.adjList().at(f)) exists = exists || a.to == s;
+            if (exists) continue;
+            int w = 1 + rng() % 9;
+            bool added = true;
+            try {
+                g.addEdge(f, s, Basic::weighted ? w : 0);
+            }
+            catch (Err&) {
+                added = false;
+            }
+            if (!added) continue;
+            if constexpr (Basic::weighted) b.addEdge(f, s, w);
+            else b.addEdge(f, s);
+        }
+        compare(g, b, rng, n, kind);
+    }
+}
+
+int main() {
+    for (unsigned seed = 1; seed <= 5; ++seed) {
+        run<BasicGraph<int, void, true>>(seed, "unweighted directed");
+        run<BasicGraph<int, void, false>>(seed, "unweighted undirected");
+        run<BasicGraph<int, int, true>>(seed, "weighted directed");
+        run<BasicGraph<int, int, false>>(seed, "weighted undirected");
+    }
+    if (failures) {
+        cerr << failures << " checks failed" << endl;
+        return 1;
+    }
+    cout << "ok" << endl;
+    return 0;
+}
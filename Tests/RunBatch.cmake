@@ -0,0 +1,14 @@
+# запускает graph_cli --batch над SCRIPT (в каталоге скрипта) с флагами MODE и сравнивает вывод с EXPECTED
+get_filename_component(dir ${SCRIPT} DIRECTORY)
+separate_arguments(flags UNIX_COMMAND "${MODE}")
+execute_process(COMMAND ${CLI} --batch ${SCRIPT} ${flags}
+  WORKING_DIRECTORY ${dir}
+  OUTPUT_VARIABLE out
+  RESULT_VARIABLE rc)
+if(NOT rc EQUAL 0)
+  message(FATAL_ERROR "graph_cli exited with ${rc}")
+endif()
+file(READ ${EXPECTED} expected)
+if(NOT out STREQUAL expected)
+  message(FATAL_ERROR "output differs from ${EXPECTED}:\n${out}")
+endif()